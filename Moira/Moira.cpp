@@ -8,8 +8,11 @@
 // -----------------------------------------------------------------------------
 
 #include <stdio.h>
+#include <stddef.h>
 #include <assert.h>
 #include <algorithm>
+#include <mutex>
+#include <string.h>
 
 #include "Moira.h"
 #include "MoiraConfig.h"
@@ -20,26 +23,70 @@ namespace moira {
 #include "MoiraALU_cpp.h"
 #include "MoiraDataflow_cpp.h"
 #include "MoiraExec_cpp.h"
+#if MOIRA_DASM
 #include "StrWriter_cpp.h"
 #include "MoiraDasm_cpp.h"
+#endif
+
+void (Moira::*Moira::exec[65536])(u16);
+#if MOIRA_DASM
+void (Moira::*Moira::dasm[65536])(StrWriter&, u32&, u16);
+#endif
+InstrInfo Moira::info[65536];
+
+u16 Moira::abcdTable[0x20000];
+u16 Moira::sbcdTable[0x20000];
 
 Moira::Moira()
 {
+    // The members accessed by each instruction must stay in the first two
+    // cache lines (Moira isn't a standard-layout class, but all supported
+    // compilers lay it out in declaration order)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+    static_assert(offsetof(Moira, flags) < 128, "Hot member moved");
+    static_assert(offsetof(Moira, unsynced) < 128, "Hot member moved");
+    static_assert(offsetof(Moira, clock) < 128, "Hot member moved");
+    static_assert(offsetof(Moira, trigger) < 128, "Hot member moved");
+    static_assert(offsetof(Moira, deadline) < 128, "Hot member moved");
+    static_assert(offsetof(Moira, directMap) < 128, "Hot member moved");
+    static_assert(offsetof(Moira, pages) < 128, "Hot member moved");
+    static_assert(offsetof(Moira, reg) < 128, "Hot member moved");
+#pragma GCC diagnostic pop
+
     createJumpTables();
+    createBcdTables();
+
+    for (int i = 0; i < 256; i++) directMap[i] = nullptr;
+    for (int i = 0; i < 256; i++) pages[i] = Page { MEM_IO, 0, 0xFF };
+    slots.start = 0;
+    slots.cycles = 1;
+    slots.count = 0;
+    slots.map = nullptr;
+    flushTLB();
+    flushVectorCache();
 }
 
 void
 Moira::reset()
 {
     flags = CPU_CHECK_IRQ;
+    if (slots.map) flags |= CPU_ARBITRATE;
+    updatePageFlag();
 
     clock = -40; // REMOVE ASAP
+    unsynced = 0;
 
     for(int i = 0; i < 8; i++) reg.d[i] = reg.a[i] = 0;
     reg.usp = 0;
     reg.ipl = 0;
     ipl = 0;
     fcl = 0;
+
+    idle.branch = idle.rejected = UINT32_MAX;
+    idle.backoff = 0;
+
+    flushVectorCache();
     
     reg.sr.t = 0;
     reg.sr.s = 1;
@@ -50,23 +97,24 @@ Moira::reset()
     reg.sr.c = 0;
     reg.sr.ipl = 7;
 
-    sync(16);
+    advance(16);
 
     // Read the initial (supervisor) stack pointer from memory
-    sync(2);
+    advance(2);
     reg.sp = read16OnReset(0);
-    sync(4);
+    advance(4);
     reg.ssp = reg.sp = read16OnReset(2) | reg.sp << 16;
-    sync(4);
+    advance(4);
     reg.pc = read16OnReset(4);
-    sync(4);
+    advance(4);
     reg.pc = read16OnReset(6) | reg.pc << 16;
 
     // Fill the prefetch queue
-    sync(4);
+    advance(4);
     queue.irc = read16OnReset(reg.pc & 0xFFFFFF);
-    sync(2);
+    advance(2);
     prefetch();
+    flushCycles();
 
     debugger.reset();
 }
@@ -88,6 +136,7 @@ Moira::execute()
 
         reg.pc += 2;
         (this->*exec[queue.ird])(queue.ird);
+        if (unsynced) flushCycles();
         return;
     }
 
@@ -114,7 +163,8 @@ Moira::execute()
     // If the CPU is stopped, poll the IPL lines and return
     if (flags & CPU_IS_STOPPED) {
         pollIrq();
-        sync(MIMIC_MUSASHI ? 1 : 2);
+        advance(stopCycles());
+        flushCycles();
         return;
     }
 
@@ -123,12 +173,19 @@ Moira::execute()
         debugger.logInstruction();
     }
 
+    // If the idle loop detector observes a loop, inspect the instruction
+    if (flags & CPU_CHECK_IDLE) {
+        checkIdleInstr(queue.ird);
+    }
+
     // Execute the instruction
     reg.pc += 2;
     (this->*exec[queue.ird])(queue.ird);
 
 done:
 
+    flushCycles();
+
     // Check if a breakpoint has been reached
     if (flags & CPU_CHECK_BP) {
         if (debugger.breakpointMatches(reg.pc)) {
@@ -137,70 +194,368 @@ done:
     }
 }
 
-bool
-Moira::checkForIrq()
+void
+Moira::executeUntil(i64 cycle)
 {
-    if (reg.ipl > reg.sr.ipl || reg.ipl == 7) {
+    deadline = cycle;
 
-        // Notify delegate
-        assert(reg.ipl < 7);
-        irqOccurred(reg.ipl);
+    while (clock < cycle) {
 
-        // Trigger interrupt
-        execIrqException(reg.ipl);
-        return true;
+        // Process all events that are due
+        if (clock >= trigger) events.serve(clock);
 
-    } else {
+        execute();
+    }
 
-        // If the polled IPL is up to date, we disable interrupt checking for
-        // the time being, because no interrupt can occur as long as the
-        // external IPL or the IPL mask inside the status register keep the
-        // same. If one of these variables changes, we reenable interrupt
-        // checking.
-        if (reg.ipl == ipl) flags &= ~CPU_CHECK_IRQ;
-        return false;
+    deadline = INT64_MIN;
+}
+
+int
+Moira::stopCycles()
+{
+    const int step = MIMIC_MUSASHI ? 1 : 2;
+
+    // Poll the IPL lines every 'step' cycles if fast-forwarding is disabled
+    if (!skipStopState) return step;
+
+    // Stay on the polling grid if an interrupt is about to trigger
+    if (reg.ipl > reg.sr.ipl || reg.ipl == 7) return step;
+
+    /* Nothing can happen before the next event or the deadline. Instead of
+     * polling the IPL lines every 'step' cycles, we jump directly to the first
+     * polling position at or after the horizon. The interrupt is therefore
+     * recognized at exactly the same cycle as in single-step mode.
+     */
+    i64 target = horizon();
+    if (target <= now() + step) return step;
+
+    i64 skip = target - now();
+    if (skip > 0x40000000) skip = 0x40000000;
+
+    return (int)((skip + step - 1) / step * step);
+}
+
+void
+Moira::configIdleDetection(bool enable)
+{
+    detectIdleLoops = enable;
+
+    idle.branch = idle.rejected = UINT32_MAX;
+    flags &= ~CPU_CHECK_IDLE;
+}
+
+void
+Moira::configStopSkipping(bool enable)
+{
+    skipStopState = enable;
+}
+
+void
+Moira::configDelayLoopSkipping(bool enable)
+{
+    skipDelayLoops = enable;
+}
+
+void
+Moira::configVectorCache(bool enable)
+{
+    cacheVectors = enable;
+    flushVectorCache();
+}
+
+void
+Moira::configRelaxedTiming(bool enable)
+{
+    relaxedTiming = enable;
+}
+
+void
+Moira::configDirectFetch(bool enable)
+{
+    directFetch = enable;
+}
+
+void
+Moira::configLongAccess(bool enable)
+{
+    longAccess = enable;
+}
+
+void
+Moira::configTranslation(bool enable)
+{
+    translation = enable;
+    flushTLB();
+}
+
+void
+Moira::flushTLB()
+{
+    for (int i = 0; i < 64; i++) tlb[i].tag = UINT32_MAX;
+
+    // Cached vectors might refer to a different physical location now
+    flushVectorCache();
+}
+
+void
+Moira::flushVectorCache()
+{
+    for (int i = 0; i < 256; i++) vectorCached[i] = false;
+}
+
+void
+Moira::mapDirect(u32 addr, u32 size, u8 *ptr)
+{
+    assert((addr & 0xFFFF) == 0 && (size & 0xFFFF) == 0);
+
+    for (u32 i = 0; i < (size >> 16); i++) {
+        directMap[((addr >> 16) + i) & 0xFF] = ptr ? ptr + (i << 16) : nullptr;
+
+        // Unbacked pages are always accessed via the bus functions
+        if (!ptr) pages[((addr >> 16) + i) & 0xFF].type = MEM_IO;
+    }
+    updatePageFlag();
+}
+
+void
+Moira::mapMemory(u32 addr, u32 size, MemType type, u8 *ptr, int wait, u8 fc)
+{
+    assert(type == MEM_IO || ptr != nullptr);
+    assert(wait >= 0 && wait <= 0xFF);
+
+    mapDirect(addr, size, ptr);
+
+    for (u32 i = 0; i < (size >> 16); i++) {
+        pages[((addr >> 16) + i) & 0xFF] = Page { (u8)type, (u8)wait, fc };
     }
+    updatePageFlag();
 }
 
-template<Size S> u32
-Moira::readD(int n)
+void
+Moira::updatePageFlag()
 {
-    return CLIP<S>(reg.d[n]);
+    flags &= ~CPU_CHECK_PAGES;
+
+    for (int i = 0; i < 256; i++) {
+
+        if (pages[i].type != MEM_IO || pages[i].wait) {
+
+            flags |= CPU_CHECK_PAGES;
+            return;
+        }
+    }
 }
 
-template<Size S> u32
-Moira::readA(int n)
+void
+Moira::setBusSlots(i64 start, int cycles, const u64 *map, int count)
 {
-    return CLIP<S>(reg.a[n]);
+    assert(cycles > 0 && count >= 0);
+
+    slots.start = start;
+    slots.cycles = cycles;
+    slots.count = map ? count : 0;
+    slots.map = map;
+
+    if (map) flags |= CPU_ARBITRATE; else flags &= ~CPU_ARBITRATE;
 }
 
-template<Size S> u32
-Moira::readR(int n)
+void
+Moira::checkIdleLoop(u32 branch, u32 target)
 {
-    return CLIP<S>(reg.r[n]);
+    /* Only fast-forward inside executeUntil() and don't skip instructions the
+     * debugger or the trace logic wants to see. With bus arbitration enabled,
+     * the duration of an iteration depends on its slot position and can't be
+     * extrapolated.
+     */
+    int blocking =
+    CPU_TRACE_FLAG | CPU_LOG_INSTRUCTION | CPU_CHECK_BP | CPU_CHECK_WP | CPU_ARBITRATE;
+
+    if (deadline == INT64_MIN || (flags & blocking)) {
+
+        idle.branch = UINT32_MAX;
+        flags &= ~CPU_CHECK_IDLE;
+        return;
+    }
+
+    // Only consider short loops
+    if (branch - target > 32) return;
+
+    if (branch != idle.branch || target != idle.head) {
+
+        // Don't observe a recently rejected loop again too soon
+        if (branch == idle.rejected && --idle.backoff > 0) return;
+
+        // Start observing a new loop candidate
+        idle.head = target;
+        idle.branch = branch;
+
+    } else if (now() < idle.trigger) {
+
+        /* The loop has been executed once without an event being processed.
+         * If only side-effect free instructions have been executed and all
+         * registers still hold the same values, all future iterations will
+         * do exactly the same until memory or the IPL pins change.
+         */
+        bool same = idle.clean && idle.sr == getSR() &&
+        memcmp(idle.r, reg.r, sizeof(idle.r)) == 0;
+
+        if (!same) {
+
+            // Stop observing this loop
+            idle.rejected = branch;
+            idle.backoff = 256;
+            idle.branch = UINT32_MAX;
+            flags &= ~CPU_CHECK_IDLE;
+            return;
+        }
+
+        // Skip as many iterations as possible
+        i64 cycles = now() - idle.cycle;
+        i64 limit = horizon();
+        if (cycles > 0 && limit - now() > cycles) {
+
+            i64 skip = (limit - now()) / cycles * cycles;
+            if (skip > 0x40000000) skip = 0x40000000 / cycles * cycles;
+            advance((int)skip);
+        }
+    }
+
+    // Start observing the next iteration
+    memcpy(idle.r, reg.r, sizeof(idle.r));
+    idle.sr = getSR();
+    idle.cycle = now();
+    idle.trigger = trigger;
+    idle.count = 0;
+    idle.clean = true;
+    flags |= CPU_CHECK_IDLE;
 }
 
-template<Size S> void
-Moira::writeD(int n, u32 v)
+void
+Moira::checkIdleInstr(u16 opcode)
+{
+    if (++idle.count > 8 || !isIdleInstr(opcode)) {
+
+        // The iteration can't be skipped. Stop inspecting instructions.
+        idle.clean = false;
+        flags &= ~CPU_CHECK_IDLE;
+    }
+}
+
+bool
+Moira::isIdleInstr(u16 opcode)
 {
-    reg.d[n] = WRITE<S>(reg.d[n], v);
+    switch (info[opcode].I) {
+
+        case TST: case CMP: case CMPA: case CMPI: case CMPM: case BTST:
+        case NOP: case MOVEQ:
+        case BRA: case BHI: case BLS: case BCC: case BCS: case BNE: case BEQ:
+        case BVC: case BVS: case BPL: case BMI: case BGE: case BLT: case BGT:
+        case BLE:
+
+            return true;
+
+        case MOVE:
+
+            // Only accept a data register as destination
+            return ((opcode >> 6) & 0b111) == 0;
+
+        default:
+
+            return false;
+    }
 }
 
-template<Size S> void
-Moira::writeA(int n, u32 v)
+void
+Moira::skipDelayLoop(int dn, i64 cycles)
 {
-    reg.a[n] = WRITE<S>(reg.a[n], v);
+    // Only fast-forward inside executeUntil()
+    i64 limit = horizon();
+    if (limit <= now() || cycles <= 0) return;
+
+    // Don't skip instructions the debugger or the trace logic wants to see
+    if (flags & (CPU_TRACE_FLAG | CPU_LOG_INSTRUCTION | CPU_CHECK_BP | CPU_CHECK_WP)) {
+        return;
+    }
+
+    // Don't skip iterations whose duration depends on the bus slot position
+    if (flags & CPU_ARBITRATE) return;
+
+    // Don't skip a pending interrupt
+    if (reg.ipl > reg.sr.ipl || reg.ipl == 7) return;
+
+    /* Each iteration decrements the counter and refills the prefetch queue
+     * with the same two words. Hence, all remaining iterations (the counter
+     * value equals their number) behave exactly like the one that has just
+     * been executed and we can compute the final state arithmetically.
+     */
+    i64 count = std::min((i64)readD<Word>(dn), (limit - now()) / cycles);
+    if (count > 0) {
+
+        writeD<Word>(dn, readD<Word>(dn) - (u32)count);
+        advance((int)(count * cycles));
+    }
 }
 
-template<Size S> void
-Moira::writeR(int n, u32 v)
+bool
+Moira::checkForIrq()
 {
-    reg.r[n] = WRITE<S>(reg.r[n], v);
+    if (reg.ipl > reg.sr.ipl || reg.ipl == 7) {
+
+        // Notify delegate
+        assert(reg.ipl < 7);
+        irqOccurred(reg.ipl);
+
+        // Trigger interrupt
+        execIrqException(reg.ipl);
+        return true;
+
+    } else {
+
+        // If the polled IPL is up to date, we disable interrupt checking for
+        // the time being, because no interrupt can occur as long as the
+        // external IPL or the IPL mask inside the status register keep the
+        // same. If one of these variables changes, we reenable interrupt
+        // checking.
+        if (reg.ipl == ipl) flags &= ~CPU_CHECK_IRQ;
+        return false;
+    }
 }
 
+/* On little endian hosts, the flags of the status register are packed and
+ * unpacked with a single multiplication. The bool fields x, n, z, v, c
+ * occupy bytes 2 to 6 of the structure. Multiplying by SR_GATHER moves
+ * each flag into the topmost byte at its CCR position (all other partial
+ * products either overflow or stay below bit 56). Multiplying the CCR by
+ * SR_SPREAD does the opposite by placing bit i in byte 6 - i.
+ */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define SR_PACKED true
+#else
+#define SR_PACKED false
+#endif
+
+static const u64 SR_FLAGS  = 0x0001010101010000;
+static const u64 SR_GATHER = 1ULL <<  8 | 1ULL << 17 | 1ULL << 26 | 1ULL << 35 | 1ULL << 44;
+static const u64 SR_SPREAD = 1ULL << 12 | 1ULL << 21 | 1ULL << 30 | 1ULL << 39 | 1ULL << 48;
+
+static_assert(sizeof(StatusRegister) == 8, "Unexpected StatusRegister layout");
+static_assert(offsetof(StatusRegister, x) == 2, "Unexpected StatusRegister layout");
+static_assert(offsetof(StatusRegister, n) == 3, "Unexpected StatusRegister layout");
+static_assert(offsetof(StatusRegister, z) == 4, "Unexpected StatusRegister layout");
+static_assert(offsetof(StatusRegister, v) == 5, "Unexpected StatusRegister layout");
+static_assert(offsetof(StatusRegister, c) == 6, "Unexpected StatusRegister layout");
+static_assert(sizeof(bool) == 1, "Unexpected size of bool");
+
 u8
 Moira::getCCR(const StatusRegister &sr)
 {
+    if (SR_PACKED) {
+
+        u64 word;
+        memcpy(&word, &sr, 8);
+        return (u8)(((word & SR_FLAGS) * SR_GATHER) >> 56);
+    }
+
     return
     sr.c << 0 |
     sr.v << 1 |
@@ -212,6 +567,15 @@ Moira::getCCR(const StatusRegister &sr)
 void
 Moira::setCCR(u8 val)
 {
+    if (SR_PACKED) {
+
+        u64 word;
+        memcpy(&word, &reg.sr, 8);
+        word = (word & ~SR_FLAGS) | (((val & 0x1F) * SR_SPREAD) & SR_FLAGS);
+        memcpy(&reg.sr, &word, 8);
+        return;
+    }
+
     reg.sr.c = (val >> 0) & 1;
     reg.sr.v = (val >> 1) & 1;
     reg.sr.z = (val >> 2) & 1;
@@ -223,7 +587,7 @@ u16
 Moira::getSR(const StatusRegister &sr)
 {
     return
-    sr.t << 15 | sr.s << 13 | sr.ipl << 8 | getCCR();
+    sr.t << 15 | sr.s << 13 | sr.ipl << 8 | getCCR(sr);
 }
 
 void
@@ -271,7 +635,7 @@ Moira::getIrqVector(int level) {
 
     assert(level < 8);
 
-    sync(4);
+    advance(4);
 
     switch (irqMode) {
 
@@ -285,6 +649,22 @@ Moira::getIrqVector(int level) {
     return 0;
 }
 
+int
+Moira::getMulCycles(Instr I, u16 data)
+{
+    assert(I == MULU || I == MULS);
+    return I == MULU ? cyclesMul<MULU>(data) : cyclesMul<MULS>(data);
+}
+
+int
+Moira::getDivCycles(Instr I, u32 dividend, u16 divisor)
+{
+    assert(I == DIVU || I == DIVS);
+    return I == DIVU ? cyclesDiv<DIVU>(dividend, divisor) : cyclesDiv<DIVS>(dividend, divisor);
+}
+
+#if MOIRA_DASM
+
 int
 Moira::disassemble(u32 addr, char *str)
 {
@@ -365,6 +745,8 @@ Moira::disassembleSR(u16 sr, char *str)
     str[16] = 0;
 }
 
+#endif
+
 // Make sure the compiler generates certain instances of template functions
 template u32 Moira::readD <Long> (int n);
 template u32 Moira::readA <Long> (int n);
@@ -10,9 +10,14 @@
 #ifndef MOIRA_H
 #define MOIRA_H
 
+#include "MoiraConfig.h"
 #include "MoiraTypes.h"
 #include "MoiraDebugger.h"
+#include "MoiraEvents.h"
+#if MOIRA_DASM
 #include "StrWriter.h"
+#endif
+#include <memory>
 
 namespace moira {
 
@@ -27,6 +32,7 @@ class Moira {
     friend class Debugger;
     friend class Breakpoints;
     friend class Watchpoints;
+    friend class EventQueue;
 
     //
     // Configuration
@@ -46,21 +52,49 @@ protected:
     // Text formatting style used by the disassembler (upper case or lower case)
     bool upper = false;
 
+#if MOIRA_DASM
     // Tab spacing used by the disassembler
     Align tab{8};
+#endif
+
+    // Indicates whether idle loops are fast-forwarded inside executeUntil()
+    bool detectIdleLoops = false;
+
+    // Indicates whether the stop state is fast-forwarded inside executeUntil()
+    bool skipStopState = false;
+
+    // Indicates whether delay loops are fast-forwarded inside executeUntil()
+    bool skipDelayLoops = false;
+
+    // Indicates whether exception vectors are cached
+    bool cacheVectors = false;
+
+    // Indicates whether sync() is called once per instruction
+    bool relaxedTiming = false;
+
+    // Indicates whether instructions are fetched directly from mapped memory
+    bool directFetch = false;
+
+    // Indicates whether long words are accessed via read32() and write32()
+    bool longAccess = false;
+
+    // Indicates whether memory addresses are passed through translate()
+    bool translation = false;
 
 
     //
     // Internals
     //
 
-public:
-
-    // Breakpoints, watchpoints, instruction tracing
-    Debugger debugger = Debugger(*this);
-
 protected:
 
+    /* The members accessed by each instruction are declared first. Together
+     * with the configuration, they are located in the first two cache lines
+     * of the object (checked in the constructor). The page tables are
+     * allocated on the heap to keep them out of the way. Tables and debugger
+     * state are placed behind them.
+     */
+
     /* State flags
      *
      * CPU_IS_HALTED:
@@ -92,6 +126,19 @@ protected:
      *
      * CPU_CHECK_WP:
      *    This flag indicates whether the CPU should check fo watchpoints.
+     *
+     * CPU_CHECK_IDLE:
+     *    This flag is set while the idle loop detector is observing a loop
+     *    candidate. If set, each executed instruction is inspected.
+     *
+     * CPU_ARBITRATE:
+     *    This flag is set while a bus slot allocation published by the host
+     *    hasn't expired. If set, the CPU waits for a free slot before each bus
+     *    access.
+     *
+     * CPU_CHECK_PAGES:
+     *    This flag is set if the host has mapped memory or assigned wait
+     *    states. If cleared, the CPU skips the page lookup on bus accesses.
      */
     int flags;
     static const int CPU_IS_HALTED         = (1 << 8);
@@ -102,10 +149,36 @@ protected:
     static const int CPU_TRACE_FLAG        = (1 << 13);
     static const int CPU_CHECK_BP          = (1 << 14);
     static const int CPU_CHECK_WP          = (1 << 15);
+    static const int CPU_CHECK_IDLE        = (1 << 16);
+    static const int CPU_ARBITRATE         = (1 << 17);
+    static const int CPU_CHECK_PAGES       = (1 << 18);
+
+    // Cycles that haven't been passed to sync() yet (relaxed timing mode)
+    int unsynced = 0;
 
     // Number of elapsed cycles since powerup
     i64 clock;
 
+    // Trigger cycle of the earliest scheduled event (maintained by 'events')
+    i64 trigger = INT64_MAX;
+
+    // Target cycle of executeUntil() (INT64_MIN if not running in this mode)
+    i64 deadline = INT64_MIN;
+
+    // Attributes of a memory page
+    struct Page {
+
+        u8 type;          // Memory type (MemType)
+        u8 wait;          // Wait states added to each bus cycle
+        u8 fc;            // Function codes granted direct access (FC n = bit n)
+    };
+
+    // Host memory pages the CPU may access directly (256 pages, 64 KB each)
+    std::unique_ptr<u8 *[]> directMap { new u8 *[256] };
+
+    // Attributes of each memory page (256 pages)
+    std::unique_ptr<Page[]> pages { new Page[256] };
+
     // The data and address registers
     Registers reg;
 
@@ -118,14 +191,71 @@ protected:
     // Value on the lower two function code pins (FC1|FC0)
     u8 fcl;
     
-    // Jump table holding the instruction handlers
-    void (Moira::*exec[65536])(u16);
+public:
+
+    // Scheduled IPL changes and host callbacks
+    EventQueue events = EventQueue(*this);
+
+    // Breakpoints, watchpoints, instruction tracing
+    Debugger debugger = Debugger(*this);
+
+protected:
+
+    // Jump table holding the instruction handlers (shared)
+    static void (Moira::*exec[65536])(u16);
+
+#if MOIRA_DASM
+    // Jump table holding the disassebler handlers (shared)
+    static void (Moira::*dasm[65536])(StrWriter&, u32&, u16);
+#endif
+
+    // Table holding instruction infos (shared)
+    static InstrInfo info[65536];
+
+    // Lookup tables for ABCD and SBCD, indexed by X:op1:op2 (shared)
+    static u16 abcdTable[0x20000];
+    static u16 sbcdTable[0x20000];
+
+    // Bus slot allocation published by the host
+    struct {
+
+        i64 start;        // Cycle at which the window begins
+        int cycles;       // Length of a single slot in cycles
+        int count;        // Number of slots in the window
+        const u64 *map;   // Allocation bitmap (bit set = occupied by DMA)
+    }
+    slots;
+
+    // Software TLB caching the translations of 4 KB pages
+    struct {
+
+        u32 tag;          // Logical page address | function code
+        u32 phys;         // Physical page address
+    }
+    tlb[64];
+
+    // Cached exception vectors
+    u32 vectors[256];
+    bool vectorCached[256];
+
+    // Physical address of the cached vector table
+    u32 vectorBase = 0;
 
-    // Jump table holding the disassebler handlers
-    void (Moira::*dasm[65536])(StrWriter&, u32&, u16);
+    // State of the idle loop detector
+    struct {
 
-    // Table holding instruction infos
-    InstrInfo info[65536];
+        u32 head;         // Target of the backward branch (loop start)
+        u32 branch;       // Address of the backward branch (loop end)
+        i64 cycle;        // Clock value when the current iteration started
+        i64 trigger;      // Next event when the current iteration started
+        u32 r[16];        // Register contents when the current iteration started
+        u16 sr;           // Status register when the current iteration started
+        int count;        // Number of executed instructions in this iteration
+        bool clean;       // Indicates if only side-effect free code has run
+        u32 rejected;     // Address of the most recently rejected branch
+        int backoff;      // Number of branches to ignore before retrying it
+
+    } idle;
 
 
     //
@@ -135,11 +265,145 @@ protected:
 public:
 
     Moira();
-    void createJumpTables();
+    static void createJumpTables();
+
+private:
+
+    // Registers the instruction handlers (one file each, to parallelize builds)
+    static void createExecTables1();   // MoiraExec1.cpp
+    static void createExecTables2();   // MoiraExec2.cpp
+#if MOIRA_DASM
+    static void createDasmTables();    // MoiraDasm.cpp
+#endif
+
+public:
 
     // Configures the output format of the disassembler
     void configDasm(bool h, bool u) { hex = h; upper = u; }
 
+    /* Enables or disables the idle loop detector.
+     * If enabled, executeUntil() fast-forwards short loops that only poll
+     * memory (e.g., "loop: tst.w $dff006; beq loop"). The detector assumes
+     * that the polled memory cells do not change before the next scheduled
+     * event. Hence, only enable it if the host utilizes the event queue to
+     * model all state changes the guest might be waiting for.
+     */
+    void configIdleDetection(bool enable);
+
+    /* Enables or disables fast-forwarding of the stop state.
+     * If enabled, executeUntil() advances a stopped CPU to the next scheduled
+     * event or the deadline in a single step instead of polling the IPL lines
+     * every few cycles. The interrupt is recognized at the same cycle as long
+     * as the IPL lines only change via the event queue. Hence, only enable it
+     * if the host doesn't call setIPL() from sync() or the bus functions.
+     */
+    void configStopSkipping(bool enable);
+
+    /* Enables or disables fast-forwarding of delay loops.
+     * If enabled, executeUntil() skips the remaining iterations of a DBcc
+     * instruction that branches to itself (e.g., "dbra d0,*") up to the next
+     * scheduled event or the deadline. Like the stop state skipping, it
+     * assumes that the IPL lines only change via the event queue.
+     */
+    void configDelayLoopSkipping(bool enable);
+
+    /* Maps a block of host memory into the address space of the CPU.
+     * Both 'addr' and 'size' must be multiples of 64 KB. The block must store
+     * all values in big endian byte order. Instructions transferring multiple
+     * registers (MOVEM) access mapped memory directly instead of calling
+     * read16() or write16(). Hence, only map RAM without side effects and
+     * keep in mind that the host isn't notified about these accesses.
+     */
+    void mapDirect(u32 addr, u32 size, u8 *ptr);
+    void unmapDirect(u32 addr, u32 size) { mapDirect(addr, size, nullptr); }
+
+    /* Assigns a memory type and bus timing to a range of the address space.
+     * Both 'addr' and 'size' must be multiples of 64 KB. RAM and ROM regions
+     * are backed by a block of host memory in big endian byte order. The CPU
+     * accesses them without calling the bus functions (writes into ROM are
+     * ignored). IO regions are accessed via read8(), read16(), etc. For IO
+     * regions, 'ptr' has the same meaning as in mapDirect(). 'wait' is the
+     * number of wait states the CPU adds to each bus cycle in the region,
+     * regardless of its type. 'fc' restricts direct accesses to the function
+     * codes whose bits are set (FC n = bit n). All other accesses are treated
+     * like IO accesses. Function codes are only tracked if EMULATE_FC is set.
+     */
+    void mapMemory(u32 addr, u32 size, MemType type,
+                   u8 *ptr = nullptr, int wait = 0, u8 fc = 0xFF);
+
+    /* Publishes the bus slot allocation of a time window.
+     * The window starts at cycle 'start' and is divided into 'count' slots of
+     * 'cycles' cycles each. Slot n is occupied by a DMA device if bit n % 64
+     * of map[n / 64] is set. Before each bus access inside the window, the
+     * CPU waits for the next free slot. Accesses outside the window aren't
+     * delayed and the CPU stops arbitrating once the window has passed. The
+     * bitmap isn't copied. Hence, it must stay valid until the window is
+     * replaced or removed. A typical host publishes a new window at the
+     * beginning of each scanline.
+     */
+    void setBusSlots(i64 start, int cycles, const u64 *map, int count);
+    void clearBusSlots() { setBusSlots(0, 1, nullptr, 0); }
+
+    /* Enables or disables the vector cache.
+     * If enabled, the CPU remembers each exception vector it has read and
+     * skips the memory access the next time (the bus cycles are still
+     * consumed). A cached vector is discarded when the CPU writes into the
+     * vector table. If address translation is enabled, writes are matched
+     * against the physical location of the table. Hence, aliased addresses
+     * are caught, too. If the vector table changes by other means (e.g., if
+     * the host switches a ROM overlay or writes into directly mapped
+     * memory), the host has to call flushVectorCache().
+     */
+    void configVectorCache(bool enable);
+    void flushVectorCache();
+
+    /* Enables or disables relaxed timing.
+     * By default, the CPU calls sync() before each bus access, which allows
+     * the host to emulate the surrounding hardware with sub-instruction
+     * accuracy. In relaxed mode, the CPU accumulates the cycles of an
+     * instruction and calls sync() once after the instruction has been
+     * executed. Hence, inside an instruction, the bus functions see the
+     * clock value at the beginning of that instruction. Scheduled events are
+     * an exception: the CPU calls sync() before serving them, so that they
+     * see the exact cycle. Use this mode if the emulated peripherals don't
+     * rely on sub-instruction timing.
+     */
+    void configRelaxedTiming(bool enable);
+
+    /* Enables or disables direct instruction fetching.
+     * If enabled, opcodes and extension words located in memory that has
+     * been mapped with mapDirect() are read from the host pointer instead of
+     * calling read16(). The prefetch queue and the bus timing are unaffected.
+     * Only enable this mode if the host doesn't need to observe instruction
+     * fetches, e.g., for emulating bus contention or ROM overlays. The
+     * feature is only compiled in if MOIRA_DIRECT_FETCH is set.
+     */
+    void configDirectFetch(bool enable);
+
+    /* Enables or disables long word accesses.
+     * By default, the CPU splits each long word access into two calls to
+     * read16() or write16(), just like the real 68000 does. If enabled, it
+     * calls read32() or write32() instead. The two bus cycles still take the
+     * same time, but the host function is called at the end of the second
+     * cycle and the order of the two words is up to the host. Only enable
+     * this mode if the host doesn't observe the two halves separately.
+     */
+    void configLongAccess(bool enable);
+
+    /* Enables or disables address translation.
+     * If enabled, the CPU passes the logical address and the function code of
+     * each bus access to translate() and accesses the returned physical
+     * address. Translations are performed for 4 KB pages and cached in a
+     * software TLB. The host has to call flushTLB() whenever it changes its
+     * mapping. The reset vector and disassembler accesses aren't translated.
+     * Function codes are only tracked if EMULATE_FC is set. The feature is
+     * only compiled in if EMULATE_MMU is set.
+     */
+    void configTranslation(bool enable);
+
+    // Discards all cached address translations
+    void flushTLB();
+
 
     //
     // Running the CPU
@@ -153,11 +417,37 @@ public:
     // Executes the next instruction
     void execute();
 
+    // Executes instructions until the clock has reached the provided cycle
+    void executeUntil(i64 cycle);
+
 private:
 
     // Invoked inside execute() to check for a pending interrupt
     bool checkForIrq();
 
+    /* Returns the cycle up to which the clock can be fast-forwarded.
+     * Fast-forwarding is only permitted inside executeUntil(). It never
+     * skips the deadline or the next scheduled event.
+     */
+    i64 horizon() { return deadline < trigger ? deadline : trigger; }
+
+    // Returns the number of cycles to spend in one iteration of the stop state
+    int stopCycles();
+
+    // Invoked by the idle loop detector when a backward branch is taken
+    void checkIdleLoop(u32 branch, u32 target);
+
+    // Invoked by the idle loop detector for each instruction inside a loop
+    void checkIdleInstr(u16 opcode);
+
+    // Indicates if an instruction can be part of an idle loop
+    bool isIdleInstr(u16 opcode);
+
+    // Skips iterations of a DBcc instruction that branches to itself
+    void skipDelayLoop(int dn, i64 cycles);
+
+
+#if MOIRA_DASM
 
     //
     // Running the disassembler
@@ -183,9 +473,19 @@ public:
     void disassembleSR(const StatusRegister &sr, char *str);
     void disassembleSR(u16 sr, char *str); // DEPRECATED
 
+#endif
+
     // Return an info struct for a certain opcode
     InstrInfo getInfo(u16 op) { return info[op]; }
 
+    /* Returns the number of cycles a MULU or MULS instruction spends in the
+     * multiplier. The result doesn't depend on MIMIC_MUSASHI.
+     */
+    int getMulCycles(Instr I, u16 data);
+
+    // Same for DIVU and DIVS (the divider)
+    int getDivCycles(Instr I, u32 dividend, u16 divisor);
+
 
     //
     // Interfacing with other components
@@ -205,6 +505,18 @@ protected:
     virtual void write8  (u32 addr, u8  val) = 0;
     virtual void write16 (u32 addr, u16 val) = 0;
 
+    // Reads or writes a long word (only called if long accesses are enabled)
+    virtual u32 read32(u32 addr) {
+        return read16(addr) << 16 | read16((addr + 2) & 0xFFFFFF); }
+    virtual void write32(u32 addr, u32 val) {
+        write16(addr, (u16)(val >> 16)); write16((addr + 2) & 0xFFFFFF, (u16)val); }
+
+    /* Translates a logical page address into a physical page address (only
+     * called if address translation is enabled). The result is applied to
+     * the whole 4 KB page.
+     */
+    virtual u32 translate(u32 addr, FunctionCode fc) { return addr; }
+
     // Provides the interrupt level in IRQ_USER mode
     virtual int readIrqUserVector(u8 level) { return 0; }
 
@@ -217,6 +529,9 @@ protected:
     // Called when a breakpoint is reached
     virtual void watchpointReached(u32 addr) { };
 
+    // Called when a scheduled callback event triggers
+    virtual void eventTriggered(i64 id) { };
+
 
     //
     // Accessing the clock
@@ -232,6 +547,17 @@ protected:
     // Advances the clock (called before each memory access)
     virtual void sync(int cycles) { clock += cycles; }
 
+private:
+
+    // Advances the clock directly or defers the sync() call in relaxed mode
+    void advance(int cycles) { if (relaxedTiming) unsynced += cycles; else sync(cycles); }
+
+    // Passes all deferred cycles to sync()
+    void flushCycles() { if (unsynced) { int cycles = unsynced; unsynced = 0; sync(cycles); } }
+
+    // Returns the clock value including all deferred cycles
+    i64 now() { return clock + unsynced; }
+
 
     //
     // Accessing registers
@@ -309,8 +635,8 @@ public:
 
 private:
 
-    // Polls the IPL pins
-    void pollIrq() { reg.ipl = ipl; }
+    // Polls the IPL pins (after processing all events that are due)
+    void pollIrq() { if (now() >= trigger) { flushCycles(); events.serve(clock); } reg.ipl = ipl; }
 
     // Selects the IRQ vector to branch to
     int getIrqVector(int level);
@@ -320,7 +646,9 @@ private:
     #include "MoiraALU.h"
     #include "MoiraDataflow.h"
     #include "MoiraExec.h"
+#if MOIRA_DASM
     #include "MoiraDasm.h"
+#endif
 };
 
 }
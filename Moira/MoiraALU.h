@@ -33,6 +33,17 @@ template <Instr I>         int  cyclesBit(u8 nr);
 template <Instr I>         int  cyclesMul(u16 data);
 template <Instr I>         int  cyclesDiv(u32 dividend, u16 divisor);
 
+/* BCD arithmetic is table driven. Each table entry holds the result byte
+ * and the flags computed by computeBcd() for a combination of both
+ * operands and the X flag.
+ */
+static const u16 BCD_C  = 0x100;  // Carry (and extend) flag
+static const u16 BCD_V  = 0x200;  // Overflow flag
+static const u16 BCD_NZ = 0x400;  // Result is non-zero (clears the Z flag)
+
+template <Instr I> static u16 computeBcd(u8 op1, u8 op2, bool x);
+static void createBcdTables();
+
 // Musashi compatibility mode
 template <Instr I>         u32    mulMusashi(u32 op1, u32 op2);
 template <Instr I>         u32    divMusashi(u32 op1, u32 op2);
@@ -49,6 +49,17 @@ template<Size S> bool ZERO(u64 data) {
     if (S == Long) return !(data & 0xFFFFFFFF);
 }
 
+static inline int BITCOUNT(u32 data) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcount(data);
+#else
+    data = data - ((data >> 1) & 0x55555555);
+    data = (data & 0x33333333) + ((data >> 2) & 0x33333333);
+    data = (data + (data >> 4)) & 0x0F0F0F0F;
+    return (data * 0x01010101) >> 24;
+#endif
+}
+
 template<Size S> u32 WRITE(u32 d1, u32 d2) {
     if (S == Byte) return (d1 & 0xFFFFFF00) | (d2 & 0x000000FF);
     if (S == Word) return (d1 & 0xFFFF0000) | (d2 & 0x0000FFFF);
@@ -58,45 +69,47 @@ template<Size S> u32 WRITE(u32 d1, u32 d2) {
 template<Instr I, Size S> u32
 Moira::shift(int cnt, u64 data) {
 
+    /* All variants are computed in closed form. The shift count ranges from
+     * 0 to 63 and 'data' holds a zero-extended operand of size S. Hence, all
+     * intermediate results fit into 64 bits.
+     */
+    const int bits = 8 * S;
+
     switch(I) {
 
         case ASL:
         {
-            bool carry = false;
-            u32 changed = 0;
-            for (int i = 0; i < cnt; i++) {
-                carry = NBIT<S>(data);
-                u64 shifted = data << 1;
-                changed |= data ^ shifted;
-                data = shifted;
+            bool carry = cnt && cnt <= bits && ((data >> (bits - cnt)) & 1);
+
+            // V is set if the MSB changes at any time during the shift
+            if (cnt >= bits) {
+                reg.sr.v = CLIP<S>(data) != 0;
+            } else {
+                u64 mask = ((2ULL << cnt) - 1) << (bits - 1 - cnt);
+                reg.sr.v = (data & mask) != 0 && (data & mask) != mask;
             }
+
+            data <<= cnt;
             if (cnt) reg.sr.x = carry;
             reg.sr.c = carry;
-            reg.sr.v = NBIT<S>(changed);
             break;
         }
         case ASR:
         {
-            bool carry = false;
-            u32 changed = 0;
-            for (int i = 0; i < cnt; i++) {
-                carry = data & 1;
-                u64 shifted = SEXT<S>(data) >> 1;
-                changed |= data ^ shifted;
-                data = shifted;
-            }
+            i64 sdata = SEXT<S>(data);
+            bool carry = cnt && ((sdata >> (cnt - 1)) & 1);
+
+            data = cnt ? (u64)(sdata >> cnt) : data;
             if (cnt) reg.sr.x = carry;
             reg.sr.c = carry;
-            reg.sr.v = NBIT<S>(changed);
+            reg.sr.v = 0;
             break;
         }
         case LSL:
         {
-            bool carry = false;
-            for (int i = 0; i < cnt; i++) {
-                carry = NBIT<S>(data);
-                data = data << 1;
-            }
+            bool carry = cnt && cnt <= bits && ((data >> (bits - cnt)) & 1);
+
+            data <<= cnt;
             if (cnt) reg.sr.x = carry;
             reg.sr.c = carry;
             reg.sr.v = 0;
@@ -104,11 +117,9 @@ Moira::shift(int cnt, u64 data) {
         }
         case LSR:
         {
-            bool carry = false;
-            for (int i = 0; i < cnt; i++) {
-                carry = data & 1;
-                data = data >> 1;
-            }
+            bool carry = cnt && ((data >> (cnt - 1)) & 1);
+
+            data >>= cnt;
             if (cnt) reg.sr.x = carry;
             reg.sr.c = carry;
             reg.sr.v = 0;
@@ -116,53 +127,49 @@ Moira::shift(int cnt, u64 data) {
         }
         case ROL:
         {
-            bool carry = false;
-            for (int i = 0; i < cnt; i++) {
-                carry = NBIT<S>(data);
-                data = data << 1 | (carry ? 1 : 0);
-            }
-            reg.sr.c = carry;
+            int r = cnt % bits;
+
+            data = CLIP<S>(data << r | data >> (bits - r));
+            reg.sr.c = cnt && (data & 1);
             reg.sr.v = 0;
             break;
         }
         case ROR:
         {
-            bool carry = false;
-            for (int i = 0; i < cnt; i++) {
-                carry = data & 1;
-                data >>= 1;
-                if (carry) data |= MSBIT<S>();
-            }
-            reg.sr.c = carry;
+            int r = cnt % bits;
+
+            data = CLIP<S>(data >> r | data << (bits - r));
+            reg.sr.c = cnt && NBIT<S>(data);
             reg.sr.v = 0;
             break;
         }
         case ROXL:
         {
-            bool carry = reg.sr.x;
-            for (int i = 0; i < cnt; i++) {
-                bool extend = carry;
-                carry = NBIT<S>(data);
-                data = data << 1 | (extend ? 1 : 0);
-            }
+            // Rotate through the X flag (bits + 1 bits in total)
+            int r = cnt % (bits + 1);
+            u64 mask = (2ULL << bits) - 1;
+            u64 ext = (u64)reg.sr.x << bits | CLIP<S>(data);
 
-            reg.sr.x = carry;
-            reg.sr.c = carry;
+            ext = (ext << r | ext >> (bits + 1 - r)) & mask;
+            data = CLIP<S>(ext);
+
+            reg.sr.x = (ext >> bits) & 1;
+            reg.sr.c = reg.sr.x;
             reg.sr.v = 0;
             break;
         }
         case ROXR:
         {
-            bool carry = reg.sr.x;
-            for (int i = 0; i < cnt; i++) {
-                bool extend = carry;
-                carry = data & 1;
-                data >>= 1;
-                if (extend) data |= MSBIT<S>();
-            }
+            // Rotate through the X flag (bits + 1 bits in total)
+            int r = cnt % (bits + 1);
+            u64 mask = (2ULL << bits) - 1;
+            u64 ext = (u64)reg.sr.x << bits | CLIP<S>(data);
 
-            reg.sr.x = carry;
-            reg.sr.c = carry;
+            ext = (ext >> r | ext << (bits + 1 - r)) & mask;
+            data = CLIP<S>(ext);
+
+            reg.sr.x = (ext >> bits) & 1;
+            reg.sr.c = reg.sr.x;
             reg.sr.v = 0;
             break;
         }
@@ -257,7 +264,7 @@ Moira::mul(u32 op1, u32 op2)
     reg.sr.v = 0;
     reg.sr.c = 0;
 
-    sync(cyclesMul<I>(op1));
+    advance(cyclesMul<I>(op1));
     return result;
 }
 
@@ -296,14 +303,29 @@ Moira::div(u32 op1, u32 op2)
     reg.sr.n = overflow ? 1        : NBIT<Word>(result);
     reg.sr.z = overflow ? reg.sr.z : ZERO<Word>(result);
 
-    sync(cyclesDiv<I>(op1, op2) - 4);
+    advance(cyclesDiv<I>(op1, op2) - 4);
     return overflow ? op1 : result;
 }
 
 template<Instr I, Size S> u32
 Moira::bcd(u32 op1, u32 op2)
+{
+    u16 entry = (I == ABCD ? abcdTable : sbcdTable)
+    [reg.sr.x << 16 | (op1 & 0xFF) << 8 | (op2 & 0xFF)];
+
+    reg.sr.x = reg.sr.c = entry & BCD_C;
+    reg.sr.v = entry & BCD_V;
+    if (entry & BCD_NZ) reg.sr.z = 0;
+    reg.sr.n = NBIT<S>(entry);
+
+    return entry & 0xFF;
+}
+
+template<Instr I> u16
+Moira::computeBcd(u8 op1, u8 op2, bool x)
 {
     u64 result;
+    u16 flags = 0;
 
     switch(I) {
 
@@ -314,16 +336,14 @@ Moira::bcd(u32 op1, u32 op2)
             u16 op2_hi = op2 & 0xF0, op2_lo = op2 & 0x0F;
 
             // From portable68000
-            u16 resLo = op1_lo + op2_lo + reg.sr.x;
+            u16 resLo = op1_lo + op2_lo + x;
             u16 resHi = op1_hi + op2_hi;
             u64 tmp_result;
             result = tmp_result = resHi + resLo;
             if (resLo > 9) result += 6;
-            reg.sr.x = reg.sr.c = (result & 0x3F0) > 0x90;
-            if (reg.sr.c) result += 0x60;
-            if (CLIP<Byte>(result)) reg.sr.z = 0;
-            reg.sr.n = NBIT<Byte>(result);
-            reg.sr.v = ((tmp_result & 0x80) == 0) && ((result & 0x80) == 0x80);
+            if ((result & 0x3F0) > 0x90) { flags |= BCD_C; result += 0x60; }
+            if (CLIP<Byte>(result)) flags |= BCD_NZ;
+            if (((tmp_result & 0x80) == 0) && ((result & 0x80) == 0x80)) flags |= BCD_V;
             break;
         }
         case SBCD:
@@ -333,7 +353,7 @@ Moira::bcd(u32 op1, u32 op2)
             u16 op2_hi = op2 & 0xF0, op2_lo = op2 & 0x0F;
 
             // From portable68000
-            u16 resLo = op2_lo - op1_lo - reg.sr.x;
+            u16 resLo = op2_lo - op1_lo - x;
             u16 resHi = op2_hi - op1_hi;
             u64 tmp_result;
             result = tmp_result = resHi + resLo;
@@ -342,12 +362,10 @@ Moira::bcd(u32 op1, u32 op2)
                 bcd = 6;
                 result -= 6;
             }
-            if (((op2 - op1 - reg.sr.x) & 0x100) > 0xff) result -= 0x60;
-            reg.sr.c = reg.sr.x = ((op2 - op1 - bcd - reg.sr.x) & 0x300) > 0xff;
-
-            if (CLIP<Byte>(result)) reg.sr.z = 0;
-            reg.sr.n = NBIT<Byte>(result);
-            reg.sr.v = ((tmp_result & 0x80) == 0x80) && ((result & 0x80) == 0);
+            if (((op2 - op1 - x) & 0x100) > 0xff) result -= 0x60;
+            if (((op2 - op1 - bcd - x) & 0x300) > 0xff) flags |= BCD_C;
+            if (CLIP<Byte>(result)) flags |= BCD_NZ;
+            if (((tmp_result & 0x80) == 0x80) && ((result & 0x80) == 0)) flags |= BCD_V;
             break;
         }
         default:
@@ -355,10 +373,31 @@ Moira::bcd(u32 op1, u32 op2)
             assert(false);
         }
     }
-    reg.sr.n = NBIT<S>(result);
-    return (u32)result;
+    return flags | CLIP<Byte>(result);
 }
 
+#ifndef MOIRA_HANDLERS_ONLY
+
+void
+Moira::createBcdTables()
+{
+    // Shared by all instances (see createJumpTables())
+    static std::once_flag once;
+    std::call_once(once, [] {
+
+        for (int i = 0; i < 0x20000; i++) {
+
+            u8 op1 = (i >> 8) & 0xFF, op2 = i & 0xFF;
+            bool x = i >> 16;
+
+            abcdTable[i] = computeBcd<ABCD>(op1, op2, x);
+            sbcdTable[i] = computeBcd<SBCD>(op1, op2, x);
+        }
+    });
+}
+
+#endif
+
 template <Size S> void
 Moira::cmp(u32 op1, u32 op2)
 {
@@ -525,14 +564,14 @@ Moira::cyclesMul(u16 data)
     {
         case MULU:
         {
-            for (; data; data >>= 1) if (data & 1) mcycles++;
-            return 2 * mcycles;
+            // Each set bit costs an extra cycle
+            return 2 * (mcycles + BITCOUNT(data));
         }
         case MULS:
         {
-            data = ((data << 1) ^ data) & 0xFFFF;
-            for (; data; data >>= 1) if (data & 1) mcycles++;
-            return 2 * mcycles;
+            // Each bit transition (including one from an implicit 0 below
+            // bit 0) costs an extra cycle
+            return 2 * (mcycles + BITCOUNT(((data << 1) ^ data) & 0xFFFF));
         }
     }
 
@@ -553,20 +592,22 @@ Moira::cyclesDiv(u32 op1, u16 op2)
 
             // Check if quotient is larger than 16 bit
             if ((dividend >> 16) >= divisor) return 10;
-            u32 hdivisor = divisor << 16;
-
-            for (int i = 0; i < 15; i++) {
-                if ((i32)dividend < 0) {
-                    dividend <<= 1;
-                    dividend -= hdivisor;
-                } else {
-                    dividend <<= 1;
-                    if (dividend >= hdivisor) {
-                        dividend -= hdivisor;
-                        mcycles += 1;
-                    } else {
-                        mcycles += 2;
-                    }
+
+            /* The microcode computes quotient bits 15 to 1 one by one. Each
+             * step takes 2 cycles if the bit is 0 and 1 cycle if the bit is 1.
+             * The step is free if the MSB of the partial remainder was set
+             * before shifting. This only happens for divisors above 0x8000,
+             * because partial remainders are always less than the divisor.
+             */
+            u32 quotient = dividend / divisor;
+            mcycles += 30 - BITCOUNT(quotient & 0xFFFE);
+
+            if (divisor > 0x8000) {
+
+                for (int i = 0; i < 15; i++) {
+
+                    u32 rem = (dividend >> (16 - i)) - divisor * (quotient >> (16 - i));
+                    mcycles -= rem >> 15;
                 }
             }
             return 2 * mcycles;
@@ -587,11 +628,10 @@ Moira::cyclesDiv(u32 op1, u16 op2)
                 mcycles += (dividend < 0) ? 1 : -1;
             }
 
+            // Each of the quotient bits 15 to 1 takes an extra cycle if cleared
             u32 aquot = abs(dividend) / abs(divisor);
-            for (int i = 0; i < 15; i++) {
-                if ( (i16)aquot >= 0) mcycles++;
-                aquot <<= 1;
-            }
+            mcycles += 15 - BITCOUNT(aquot & 0xFFFE);
+
             return 2 * mcycles;
         }
     }
@@ -637,7 +677,7 @@ Moira::divMusashi(u32 op1, u32 op2)
 
         case DIVS:
         {
-            sync(154);
+            advance(154);
 
             if (op1 == 0x80000000 && (i32)op2 == -1) {
 
@@ -669,7 +709,7 @@ Moira::divMusashi(u32 op1, u32 op2)
         }
         case DIVU:
         {
-            sync(136);
+            advance(136);
 
             i64 quotient  = op1 / op2;
             u16 remainder = op1 % op2;
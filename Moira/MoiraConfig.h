@@ -29,6 +29,16 @@
  */
 #define EMULATE_FC true
 
+/* Set to true to emulate an external memory management unit (MMU).
+ *
+ * If enabled, configTranslation() can be used to pass each memory address
+ * through the translate() hook. If disabled, address translation isn't
+ * compiled in and configTranslation() has no effect.
+ *
+ * Enable to improve emulation compatibility, disable to gain speed.
+ */
+#define EMULATE_MMU false
+
 /* Set to true to run Moira in a special Musashi compatibility mode.
  *
  * The compatibility mode is used by the test runner application to compare
@@ -38,4 +48,36 @@
  */
 #define MIMIC_MUSASHI true
 
+/* Set to true to build a code-size-optimized variant.
+ *
+ * By default, each instruction handler is instantiated for all combinations
+ * of addressing modes and sizes it supports. In the compact variant, rarely
+ * executed instructions (ABCD, SBCD, NBCD, CHK, MOVE to CCR, MOVE to SR)
+ * share a single handler that determines the addressing mode at runtime.
+ * 'make size' in the Moira directory prints the code size of each handler.
+ *
+ * Enable to reduce the code size, disable to gain speed.
+ */
+#define MOIRA_COMPACT false
+
+/* Set to false to exclude the disassembler.
+ *
+ * If disabled, the disassembler jump table, the disassembler handlers, and
+ * the disassemble...() API are not compiled in. The test runner application
+ * requires the disassembler.
+ *
+ * Disable to reduce the code size.
+ */
+#define MOIRA_DASM true
+
+/* Set to true to compile in direct instruction fetching.
+ *
+ * If enabled, configDirectFetch() can be used to read opcodes and extension
+ * words from memory that has been mapped with mapDirect(). If disabled, the
+ * feature isn't compiled in and configDirectFetch() has no effect.
+ *
+ * Enable to gain speed if the host maps its memory, disable otherwise.
+ */
+#define MOIRA_DIRECT_FETCH false
+
 #endif
@@ -0,0 +1,165 @@
+// -----------------------------------------------------------------------------
+// This file is part of Moira - A Motorola 68k emulator
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "MoiraCoordinator.h"
+#include <algorithm>
+#include <assert.h>
+
+namespace moira {
+
+int
+Coordinator::add(Moira &cpu)
+{
+    cpus.push_back(&cpu);
+    pending.push_back(std::vector<Write>());
+    overlay.push_back(std::unordered_map<u32, u8>());
+
+    if (scheduler) scheduler->add(cpu, 0);
+    return (int)cpus.size() - 1;
+}
+
+void
+Coordinator::configQuantum(i64 cycles)
+{
+    assert(cycles > 0);
+    quantum = cycles;
+}
+
+void
+Coordinator::configParallel(int threads)
+{
+    commit();
+    scheduler.reset();
+
+    if (threads > 0) {
+
+        scheduler.reset(new Scheduler(threads));
+        scheduler->configSlice(INT64_MAX / 2);
+        for (auto cpu : cpus) scheduler->add(*cpu, 0);
+    }
+}
+
+void
+Coordinator::mapShared(u32 addr, u32 size, u8 *mem)
+{
+    sharedStart = addr;
+    sharedSize = mem ? size : 0;
+    shared = mem;
+}
+
+u8
+Coordinator::read8(int cpu, u32 addr)
+{
+    assert(isShared(addr));
+
+    // Overlay the pending writes of the accessing CPU
+    if (scheduler && !overlay[cpu].empty()) {
+
+        auto it = overlay[cpu].find(addr);
+        if (it != overlay[cpu].end()) return it->second;
+    }
+    return shared[addr - sharedStart];
+}
+
+u16
+Coordinator::read16(int cpu, u32 addr)
+{
+    return (u16)(read8(cpu, addr) << 8 | read8(cpu, addr + 1));
+}
+
+void
+Coordinator::write8(int cpu, u32 addr, u8 val)
+{
+    assert(isShared(addr));
+
+    if (scheduler) {
+        pending[cpu].push_back(Write { cpus[cpu]->getClock(), cpu, addr, val, false });
+        overlay[cpu][addr] = val;
+    } else {
+        poke(addr, val, false);
+    }
+}
+
+void
+Coordinator::write16(int cpu, u32 addr, u16 val)
+{
+    assert(isShared(addr) && isShared(addr + 1));
+
+    if (scheduler) {
+        pending[cpu].push_back(Write { cpus[cpu]->getClock(), cpu, addr, val, true });
+        overlay[cpu][addr] = (u8)(val >> 8);
+        overlay[cpu][addr + 1] = (u8)val;
+    } else {
+        poke(addr, val, true);
+    }
+}
+
+void
+Coordinator::poke(u32 addr, u16 val, bool word)
+{
+    if (word) {
+        shared[addr - sharedStart] = (u8)(val >> 8);
+        shared[addr - sharedStart + 1] = (u8)val;
+    } else {
+        shared[addr - sharedStart] = (u8)val;
+    }
+}
+
+void
+Coordinator::runUntil(i64 cycle)
+{
+    if (cpus.empty()) return;
+
+    // Start at the clock of the CPU that is furthest behind
+    if (barrier == INT64_MIN) {
+
+        barrier = cpus[0]->getClock();
+        for (auto cpu : cpus) barrier = std::min(barrier, cpu->getClock());
+    }
+
+    while (barrier < cycle) {
+
+        i64 next = std::min(barrier + quantum, cycle);
+
+        if (scheduler) {
+
+            for (int i = 0; i < (int)cpus.size(); i++) {
+                scheduler->setBudget(i, next - cpus[i]->getClock());
+            }
+            scheduler->run();
+            commit();
+
+        } else {
+
+            for (auto cpu : cpus) cpu->executeUntil(next);
+        }
+        barrier = next;
+    }
+}
+
+void
+Coordinator::commit()
+{
+    std::vector<Write> writes;
+
+    for (auto &list : pending) {
+        writes.insert(writes.end(), list.begin(), list.end());
+        list.clear();
+    }
+    for (auto &map : overlay) map.clear();
+
+    // Order by time stamp. Simultaneous writes are ordered by CPU id.
+    std::stable_sort(writes.begin(), writes.end(), [](const Write &w1, const Write &w2) {
+        return w1.cycle < w2.cycle || (w1.cycle == w2.cycle && w1.cpu < w2.cpu);
+    });
+
+    for (auto &w : writes) poke(w.addr, w.value, w.word);
+}
+
+}
@@ -0,0 +1,128 @@
+// -----------------------------------------------------------------------------
+// This file is part of Moira - A Motorola 68k emulator
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#ifndef MOIRA_COORDINATOR_H
+#define MOIRA_COORDINATOR_H
+
+#include "MoiraScheduler.h"
+#include <unordered_map>
+
+namespace moira {
+
+/* Runs multiple CPUs of a single system in lockstep.
+ *
+ * All CPUs are advanced in quanta. At the end of each quantum, all CPUs have
+ * reached a common clock barrier (they may overshoot it by the cycles of a
+ * single instruction). In serial mode, the CPUs run one after another inside
+ * each quantum and access the shared memory directly. In parallel mode,
+ * the CPUs of a quantum run on separate threads. All writes into the shared
+ * memory are deferred to the barrier and performed in the order of their
+ * cycle stamps. Inside a quantum, a CPU sees the shared memory as it was at
+ * the last barrier, overlaid with its own pending writes. Hence, the results
+ * are deterministic and don't depend on the number of threads.
+ *
+ * The host connects the shared memory by calling read8(), read16(),
+ * write8(), and write16() of the coordinator from the corresponding bus
+ * functions of each CPU for all addresses inside the shared area.
+ */
+class Coordinator {
+
+    struct Write {
+
+        i64 cycle;        // CPU clock at the time of the write
+        int cpu;          // Id of the writing CPU
+        u32 addr;         // Target address
+        u16 value;        // Written value
+        bool word;        // Indicates a word (true) or a byte (false) access
+    };
+
+protected:
+
+    // The connected CPUs
+    std::vector<Moira *> cpus;
+
+    // Number of cycles between two barriers
+    i64 quantum = 1000;
+
+    // Clock value of the most recent barrier (INT64_MIN if not set yet)
+    i64 barrier = INT64_MIN;
+
+    // Worker pool used in parallel mode
+    std::unique_ptr<Scheduler> scheduler;
+
+    // The shared memory area (big endian)
+    u8 *shared = nullptr;
+    u32 sharedStart = 0;
+    u32 sharedSize = 0;
+
+    // Deferred writes into the shared memory (one list per CPU)
+    std::vector<std::vector<Write>> pending;
+
+    // Latest pending value of each written byte (one map per CPU)
+    std::vector<std::unordered_map<u32, u8>> overlay;
+
+
+    //
+    // Constructing and configuring
+    //
+
+public:
+
+    // Adds a CPU and returns its id
+    int add(Moira &cpu);
+
+    // Sets the number of cycles between two barriers
+    void configQuantum(i64 cycles);
+
+    // Enables parallel mode with the given number of threads (0 = disable)
+    void configParallel(int threads);
+
+    // Connects the memory area shared by all CPUs
+    void mapShared(u32 addr, u32 size, u8 *mem);
+
+    // Returns the clock value of the most recent barrier
+    i64 getBarrier() { return barrier; }
+
+
+    //
+    // Accessing the shared memory
+    //
+
+public:
+
+    bool isShared(u32 addr) { return addr - sharedStart < sharedSize; }
+
+    u8 read8(int cpu, u32 addr);
+    u16 read16(int cpu, u32 addr);
+    void write8(int cpu, u32 addr, u8 val);
+    void write16(int cpu, u32 addr, u16 val);
+
+private:
+
+    // Performs a write access on the shared memory
+    void poke(u32 addr, u16 val, bool word);
+
+
+    //
+    // Running the CPUs
+    //
+
+public:
+
+    // Advances all CPUs quantum by quantum until 'cycle' has been reached
+    void runUntil(i64 cycle);
+
+private:
+
+    // Performs all deferred writes in a deterministic order
+    void commit();
+};
+
+}
+#endif
@@ -0,0 +1,46 @@
+// -----------------------------------------------------------------------------
+// This file is part of Moira - A Motorola 68k emulator
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "MoiraConfig.h"
+
+#if MOIRA_DASM
+
+#include <stdio.h>
+#include <assert.h>
+#include <algorithm>
+#include <string.h>
+
+#include "Moira.h"
+
+// All functions but the instruction handlers are compiled in Moira.cpp
+#define MOIRA_HANDLERS_ONLY
+
+namespace moira {
+
+#include "MoiraInit_cpp.h"
+#include "MoiraALU_cpp.h"
+#include "MoiraDataflow_cpp.h"
+#include "MoiraExec_cpp.h"
+#include "StrWriter_cpp.h"
+#include "MoiraDasm_cpp.h"
+
+#define bind(id, name, I, M, S) bindDasm(id, name, I, M, S)
+#define MOIRA_PART 0
+
+void
+Moira::createDasmTables()
+{
+    u16 opcode;
+
+    #include "MoiraTables_cpp.h"
+}
+
+}
+
+#endif
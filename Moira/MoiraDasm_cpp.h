@@ -7,21 +7,21 @@
 // See https://www.gnu.org for license information
 // -----------------------------------------------------------------------------
 
-template <> u32
+template <> inline u32
 Moira::dasmRead<Byte>(u32 &addr)
 {
     addr += 2;
     return read16Dasm(addr) & 0xFF;
 }
 
-template <> u32
+template <> inline u32
 Moira::dasmRead<Word>(u32 &addr)
 {
     addr += 2;
     return read16Dasm(addr);
 }
 
-template <> u32
+template <> inline u32
 Moira::dasmRead<Long>(u32 &addr)
 {
     u32 result = dasmRead<Word>(addr) << 16;
@@ -29,7 +29,7 @@ Moira::dasmRead<Long>(u32 &addr)
     return result;
 }
 
-int
+inline int
 Moira::baseDispWords(u16 ext)
 {
     u16 xx = __________xx____ (ext);
@@ -40,7 +40,7 @@ Moira::baseDispWords(u16 ext)
     return base_disp ? (base_disp_long ? 2 : 1) : 0;
 }
 
-int
+inline int
 Moira::outerDispWords(u16 ext)
 {
     u16 xx = ______________xx (ext);
@@ -107,6 +107,8 @@ Moira::Op(u16 reg, u32 &pc)
     return result;
 }
 
+#ifndef MOIRA_HANDLERS_ONLY
+
 void
 Moira::dasmIllegal(StrWriter &str, u32 &addr, u16 op)
 {
@@ -125,6 +127,8 @@ Moira::dasmLineF(StrWriter &str, u32 &addr, u16 op)
     str << "dc.w " << tab << UInt16{op} << "; opcode 1111";
 }
 
+#endif
+
 template<Instr I, Mode M, Size S> void
 Moira::dasmShiftRg(StrWriter &str, u32 &addr, u16 op)
 {
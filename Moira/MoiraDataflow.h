@@ -61,6 +61,9 @@
  */
 template<Mode M, Size S> bool readOp(int n, u32 &ea, u32 &result);
 
+// Reads an operand with an addressing mode that is determined at runtime
+template<Size S> bool readOp(Mode M, int n, u32 &ea, u32 &result);
+
 /* Writes an operand
  *
  * If parameter ea is omitted, the destination of the operand is determined
@@ -90,6 +93,42 @@ template<Size S, bool last = false> void writeM(u32 addr, u32 val, bool &error);
 template<Size S, bool last = false> void writeMrev(u32 addr, u32 val);
 template<Size S, bool last = false> void writeMrev(u32 addr, u32 val, bool &error);
 
+/* Transfers a block of registers from or to directly mapped memory
+ *
+ * These functions are utilized by MOVEM. They return false if the memory
+ * block can't be accessed directly. In this case, nothing is transferred
+ * and the caller has to fall back to readM() and writeM().
+ */
+template<Size S> bool readMBlock(u32 addr, u16 mask);
+template<Size S> bool writeMBlock(u32 addr, u16 mask);
+
+// Writes consecutive words to directly mapped memory (used for stack frames)
+bool writeMDirect(u32 addr, const u16 *words, int count);
+
+// Returns a pointer into directly mapped memory (or NULL if unmapped)
+u8 *directPtr(u32 addr, u32 size);
+
+// Sets or clears CPU_CHECK_PAGES according to the page attributes
+void updatePageFlag();
+
+// Returns the attributes of the memory page containing the given address
+const Page &pageOf(u32 addr) { return pages[(addr >> 16) & 0xFF]; }
+
+// Checks if the current function code is granted direct access to a page
+bool fcMatches(const Page &page) { return (page.fc >> readFC()) & 1; }
+
+// Checks if an access bypasses the bus functions of the host
+bool isDirect(const Page &page) { return page.type != MEM_IO && fcMatches(page); }
+
+// Returns the number of cycles until the next free bus slot
+int busStall();
+
+// Translates a logical address into a physical address via the TLB
+u32 translateAddr(u32 addr);
+
+// Reads an instruction word (bypassing read16() in direct fetch mode)
+template<bool last = false> u16 readP(u32 addr);
+
 // Reads an immediate value from memory
  template<Size S> u32 readI();
 
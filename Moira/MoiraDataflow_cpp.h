@@ -9,6 +9,42 @@
 
 #define LAST_BUS_CYCLE true
 
+template<Size S> u32
+Moira::readD(int n)
+{
+    return CLIP<S>(reg.d[n]);
+}
+
+template<Size S> u32
+Moira::readA(int n)
+{
+    return CLIP<S>(reg.a[n]);
+}
+
+template<Size S> u32
+Moira::readR(int n)
+{
+    return CLIP<S>(reg.r[n]);
+}
+
+template<Size S> void
+Moira::writeD(int n, u32 v)
+{
+    reg.d[n] = WRITE<S>(reg.d[n], v);
+}
+
+template<Size S> void
+Moira::writeA(int n, u32 v)
+{
+    reg.a[n] = WRITE<S>(reg.a[n], v);
+}
+
+template<Size S> void
+Moira::writeR(int n, u32 v)
+{
+    reg.r[n] = WRITE<S>(reg.r[n], v);
+}
+
 template<Mode M, Size S> bool
 Moira::readOp(int n, u32 &ea, u32 &result)
 {
@@ -40,6 +76,30 @@ Moira::readOp(int n, u32 &ea, u32 &result)
     return !error;
 }
 
+template<Size S> bool
+Moira::readOp(Mode M, int n, u32 &ea, u32 &result)
+{
+    switch (M) {
+
+        case MODE_DN:   return readOp<MODE_DN,   S>(n, ea, result);
+        case MODE_AN:   return readOp<MODE_AN,   S>(n, ea, result);
+        case MODE_AI:   return readOp<MODE_AI,   S>(n, ea, result);
+        case MODE_PI:   return readOp<MODE_PI,   S>(n, ea, result);
+        case MODE_PD:   return readOp<MODE_PD,   S>(n, ea, result);
+        case MODE_DI:   return readOp<MODE_DI,   S>(n, ea, result);
+        case MODE_IX:   return readOp<MODE_IX,   S>(n, ea, result);
+        case MODE_AW:   return readOp<MODE_AW,   S>(n, ea, result);
+        case MODE_AL:   return readOp<MODE_AL,   S>(n, ea, result);
+        case MODE_DIPC: return readOp<MODE_DIPC, S>(n, ea, result);
+        case MODE_PCIX: return readOp<MODE_PCIX, S>(n, ea, result);
+        case MODE_IM:   return readOp<MODE_IM,   S>(n, ea, result);
+
+        default:
+            assert(false);
+            return false;
+    }
+}
+
 template<Mode M, Size S, bool last> bool
 Moira::writeOp(int n, u32 val)
 {
@@ -109,7 +169,7 @@ Moira::computeEA(u32 n) {
         }
         case 4:  // -(An)
         {
-            sync(2);
+            advance(2);
             result = readA(n) - ((n == 7 && S == Byte) ? 2 : S);
             break;
         }
@@ -130,7 +190,7 @@ Moira::computeEA(u32 n) {
 
             result = d + an + ((queue.irc & 0x800) ? xi : SEXT<Word>(xi));
 
-            sync(2);
+            advance(2);
             readExt<skip>();
             break;
         }
@@ -162,7 +222,7 @@ Moira::computeEA(u32 n) {
             u32 xi = readR((queue.irc >> 12) & 0b1111);
 
             result = d + reg.pc + ((queue.irc & 0x800) ? xi : SEXT<Word>(xi));
-            sync(2);
+            advance(2);
             readExt<skip>();
             break;
         }
@@ -210,6 +270,21 @@ Moira::readM(u32 addr)
     u32 result;
 
     if (S == Long) {
+
+        if (longAccess && !(EMULATE_MMU && translation) && !(flags & (CPU_CHECK_WP | CPU_ARBITRATE))) {
+
+            const Page &p1 = pageOf(addr), &p2 = pageOf(addr + 2);
+
+            if (!isDirect(p1) && !isDirect(p2)) {
+
+                advance(6 + p1.wait + p2.wait);
+                if (last) pollIrq();
+                result = read32(addr & 0xFFFFFF);
+                advance(2);
+                return result;
+            }
+        }
+
         result = readM<Word>(addr) << 16;
         result |= readM<Word,last>(addr + 2);
         return result;
@@ -220,18 +295,45 @@ Moira::readM(u32 addr)
         watchpointReached(addr);
     }
 
+    if (EMULATE_MMU && translation) addr = translateAddr(addr);
+
+    // Skip the page lookup if all memory is accessed via the bus functions
+    if (!(flags & (CPU_CHECK_PAGES | CPU_ARBITRATE))) {
+
+        advance(2);
+        if (last) pollIrq();
+        result = S == Byte ? read8(addr & 0xFFFFFF) : read16(addr & 0xFFFFFF);
+        advance(2);
+        return result;
+    }
+
+    const Page &page = pageOf(addr);
+
+    // Wait for a free bus slot
+    if (flags & CPU_ARBITRATE) advance(busStall());
+
     if (S == Byte) {
-        sync(2);
+        advance(2 + page.wait);
         if (last) pollIrq();
-        result = read8(addr & 0xFFFFFF);
-        sync(2);
+        if (isDirect(page)) {
+            result = directMap[(addr >> 16) & 0xFF][addr & 0xFFFF];
+        } else {
+            result = read8(addr & 0xFFFFFF);
+        }
+        advance(2);
     }
 
     if (S == Word) {
-        sync(2);
+        advance(2 + page.wait);
         if (last) pollIrq();
-        result = read16(addr & 0xFFFFFF);
-        sync(2);
+        // Words crossing the end of a page are accessed via the bus functions
+        if (isDirect(page) && (addr & 0xFFFF) != 0xFFFF) {
+            u8 *p = directMap[(addr >> 16) & 0xFF] + (addr & 0xFFFF);
+            result = p[0] << 8 | p[1];
+        } else {
+            result = read16(addr & 0xFFFFFF);
+        }
+        advance(2);
     }
 
     return result;
@@ -248,6 +350,26 @@ template<Size S, bool last> void
 Moira::writeM(u32 addr, u32 val)
 {
     if (S == Long) {
+
+        if (EMULATE_FC) fcl = 1;
+
+        if (longAccess && !(EMULATE_MMU && translation) && !(flags & (CPU_CHECK_WP | CPU_ARBITRATE))) {
+
+            const Page &p1 = pageOf(addr), &p2 = pageOf(addr + 2);
+
+            if (!isDirect(p1) && !isDirect(p2)) {
+
+                if (!(addr & 0xFFFC00)) vectorCached[(addr >> 2) & 0xFF] = false;
+                if (!((addr + 2) & 0xFFFC00)) vectorCached[((addr + 2) >> 2) & 0xFF] = false;
+
+                advance(6 + p1.wait + p2.wait);
+                if (last) pollIrq();
+                write32(addr & 0xFFFFFF, val);
+                advance(2);
+                return;
+            }
+        }
+
         writeM<Word>     (addr,     val >> 16   );
         writeM<Word,last>(addr + 2, val & 0xFFFF);
         return;
@@ -260,18 +382,51 @@ Moira::writeM(u32 addr, u32 val)
         watchpointReached(addr);
     }
 
+    if (EMULATE_MMU && translation) addr = translateAddr(addr);
+
+    // Discard the cached exception vector if the vector table is written
+    u32 offset = addr - (EMULATE_MMU ? vectorBase : 0);
+    if (!(offset & 0xFFFC00)) vectorCached[(offset >> 2) & 0xFF] = false;
+
+    // Skip the page lookup if all memory is accessed via the bus functions
+    if (!(flags & (CPU_CHECK_PAGES | CPU_ARBITRATE))) {
+
+        advance(2);
+        if (last) pollIrq();
+        if (S == Byte) write8(addr & 0xFFFFFF, (u8)val);
+        if (S == Word) write16(addr & 0xFFFFFF, (u16)val);
+        advance(2);
+        return;
+    }
+
+    const Page &page = pageOf(addr);
+
+    // Wait for a free bus slot
+    if (flags & CPU_ARBITRATE) advance(busStall());
+
     if (S == Byte) {
-        sync(2);
+        advance(2 + page.wait);
         if (last) pollIrq();
-        write8(addr & 0xFFFFFF, (u8)val);
-        sync(2);
+        if (!isDirect(page)) {
+            write8(addr & 0xFFFFFF, (u8)val);
+        } else if (page.type == MEM_RAM) {
+            directMap[(addr >> 16) & 0xFF][addr & 0xFFFF] = (u8)val;
+        }
+        advance(2);
     }
 
     if (S == Word) {
-        sync(2);
+        advance(2 + page.wait);
         if (last) pollIrq();
-        write16(addr & 0xFFFFFF, (u16)val);
-        sync(2);
+        // Words crossing the end of a page are accessed via the bus functions
+        if (!isDirect(page) || (addr & 0xFFFF) == 0xFFFF) {
+            write16(addr & 0xFFFFFF, (u16)val);
+        } else if (page.type == MEM_RAM) {
+            u8 *p = directMap[(addr >> 16) & 0xFF] + (addr & 0xFFFF);
+            p[0] = (u8)(val >> 8);
+            p[1] = (u8)val;
+        }
+        advance(2);
     }
 }
 
@@ -295,6 +450,12 @@ Moira::writeMrev(u32 addr, u32 val)
         }
         case Long:
         {
+            if (EMULATE_FC) fcl = 1;
+            if (longAccess && !(EMULATE_MMU && translation) && !(flags & (CPU_CHECK_WP | CPU_ARBITRATE)) &&
+                !isDirect(pageOf(addr)) && !isDirect(pageOf(addr + 2))) {
+                writeM<Long,last>(addr, val);
+                break;
+            }
             writeM<Word>     (addr + 2, val & 0xFFFF);
             writeM<Word,last>(addr,     val >> 16   );
             break;
@@ -309,6 +470,194 @@ Moira::writeMrev(u32 addr, u32 val, bool &error)
     writeMrev<S,last>(addr, val);
 }
 
+template<Size S> bool
+Moira::readMBlock(u32 addr, u16 mask)
+{
+    // Watchpoints, bus arbitration, and translation require the ordinary
+    // access path
+    if ((flags & (CPU_CHECK_WP | CPU_ARBITRATE)) || (EMULATE_MMU && translation)) return false;
+
+    int cnt = 0;
+    for (u16 m = mask; m; m &= m - 1) cnt++;
+
+    u8 *p = cnt ? directPtr(addr, cnt * S) : nullptr;
+    if (!p || !fcMatches(pageOf(addr))) return false;
+
+    // Each word transfer takes four cycles plus the wait states
+    advance((4 + pageOf(addr).wait) * S / 2 * cnt);
+
+    for(int i = 0; i <= 15; i++) {
+
+        if (mask & (1 << i)) {
+
+            u32 val = p[0] << 8 | p[1];
+            if (S == Long) val = val << 16 | p[2] << 8 | p[3];
+            writeR(i, SEXT<S>(val));
+            p += S;
+        }
+    }
+    return true;
+}
+
+template<Size S> bool
+Moira::writeMBlock(u32 addr, u16 mask)
+{
+    // Watchpoints, bus arbitration, and translation require the ordinary
+    // access path
+    if ((flags & (CPU_CHECK_WP | CPU_ARBITRATE)) || (EMULATE_MMU && translation)) return false;
+
+    int cnt = 0;
+    for (u16 m = mask; m; m &= m - 1) cnt++;
+
+    if (EMULATE_FC) fcl = 1;
+    const Page &page = pageOf(addr);
+
+    u8 *p = cnt ? directPtr(addr, cnt * S) : nullptr;
+    if (!p || !fcMatches(page) || page.type == MEM_ROM) return false;
+
+    if (!(addr & 0xFFFC00)) flushVectorCache();
+
+    // Each word transfer takes four cycles plus the wait states
+    advance((4 + page.wait) * S / 2 * cnt);
+
+    for(int i = 0; i <= 15; i++) {
+
+        if (mask & (1 << i)) {
+
+            u32 val = reg.r[i];
+            if (S == Long) { *p++ = (u8)(val >> 24); *p++ = (u8)(val >> 16); }
+            *p++ = (u8)(val >> 8);
+            *p++ = (u8)val;
+        }
+    }
+    return true;
+}
+
+#ifndef MOIRA_HANDLERS_ONLY
+
+bool
+Moira::writeMDirect(u32 addr, const u16 *words, int count)
+{
+    // Watchpoints, bus arbitration, translation, and odd addresses require
+    // the ordinary access path
+    if ((flags & (CPU_CHECK_WP | CPU_ARBITRATE)) || (EMULATE_MMU && translation) || (addr & 1)) return false;
+
+    if (EMULATE_FC) fcl = 1;
+    const Page &page = pageOf(addr);
+
+    u8 *p = directPtr(addr, 2 * count);
+    if (!p || !fcMatches(page) || page.type == MEM_ROM) return false;
+
+    if (!(addr & 0xFFFC00)) flushVectorCache();
+
+    // Each word transfer takes four cycles plus the wait states
+    advance((4 + page.wait) * count);
+
+    for (int i = 0; i < count; i++) {
+
+        *p++ = (u8)(words[i] >> 8);
+        *p++ = (u8)words[i];
+    }
+    return true;
+}
+
+// Returns the number of trailing zeros (data must not be zero)
+static inline int TRAILZEROS(u64 data) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(data);
+#else
+    int n = 0;
+    if (!(data & 0xFFFFFFFF)) { data >>= 32; n += 32; }
+    if (!(data & 0xFFFF)) { data >>= 16; n += 16; }
+    if (!(data & 0xFF)) { data >>= 8; n += 8; }
+    if (!(data & 0xF)) { data >>= 4; n += 4; }
+    if (!(data & 0x3)) { data >>= 2; n += 2; }
+    return n + !(data & 1);
+#endif
+}
+
+int
+Moira::busStall()
+{
+    i64 cycle = now();
+    if (cycle < slots.start) return 0;
+
+    // Stop arbitrating once the window has passed
+    if (cycle >= slots.start + (i64)slots.count * slots.cycles) {
+
+        slots.map = nullptr;
+        slots.count = 0;
+        flags &= ~CPU_ARBITRATE;
+        return 0;
+    }
+
+    // Find the first free slot, starting with the current one
+    i64 n = (cycle - slots.start) / slots.cycles;
+    while (n < slots.count) {
+
+        u64 free = ~slots.map[n >> 6] >> (n & 63);
+        if (free) { n += TRAILZEROS(free); break; }
+        n = (n | 63) + 1;
+    }
+
+    // The bus is free again once the window has passed
+    if (n > slots.count) n = slots.count;
+
+    i64 begin = slots.start + n * slots.cycles;
+    return begin > cycle ? (int)(begin - cycle) : 0;
+}
+
+#endif
+
+inline u32
+Moira::translateAddr(u32 addr)
+{
+    FunctionCode fc = readFC();
+    u32 tag = (addr & 0xFFF000) | fc;
+    auto &entry = tlb[((addr >> 12) ^ (fc << 3)) & 63];
+
+    if (entry.tag != tag) {
+
+        entry.tag = tag;
+        entry.phys = translate(addr & 0xFFF000, fc) & 0xFFF000;
+    }
+    return entry.phys | (addr & 0xFFF);
+}
+
+inline u8 *
+Moira::directPtr(u32 addr, u32 size)
+{
+    addr &= 0xFFFFFF;
+
+    // The block must not cross a page boundary
+    if ((addr ^ (addr + size - 1)) & 0xFF0000) return nullptr;
+
+    u8 *page = directMap[addr >> 16];
+    return page ? page + (addr & 0xFFFF) : nullptr;
+}
+
+template<bool last> u16
+Moira::readP(u32 addr)
+{
+    if (MOIRA_DIRECT_FETCH && directFetch && !(flags & CPU_CHECK_WP)) {
+
+        u32 phys = (EMULATE_MMU && translation) ? translateAddr(addr) : addr;
+        u8 *p = directPtr(phys, 2);
+        const Page &page = pageOf(phys);
+
+        if (p && fcMatches(page)) {
+
+            if (flags & CPU_ARBITRATE) advance(busStall());
+            advance(2 + page.wait);
+            if (last) pollIrq();
+            u16 result = (u16)(p[0] << 8 | p[1]);
+            advance(2);
+            return result;
+        }
+    }
+    return (u16)readM<Word,last>(addr);
+}
+
 template<Size S> u32
 Moira::readI()
 {
@@ -325,6 +674,16 @@ Moira::readI()
             break;
         case Long:
             result = queue.irc << 16;
+            if (longAccess && !(MOIRA_DIRECT_FETCH && directFetch) && !(reg.pc & 1)) {
+
+                // Fetch both extension words with a single bus call
+                if (EMULATE_FC) fcl = 2;
+                u32 words = readM<Long>(reg.pc + 2);
+                reg.pc += 4;
+                result |= words >> 16;
+                queue.irc = (u16)words;
+                break;
+            }
             readExt();
             result |= queue.irc;
             readExt();
@@ -347,7 +706,7 @@ Moira::addressReadError(u32 addr)
     if (EMULATE_ADDRESS_ERROR) {
 
         if ((addr & 1) && S != Byte) {
-            sync(delay);
+            advance(delay);
             execAddressError(addr, true);
             return true;
         }
@@ -361,7 +720,7 @@ Moira::addressWriteError(u32 addr)
     if (EMULATE_ADDRESS_ERROR) {
 
         if ((addr & 1) && S != Byte) {
-            sync(delay);
+            advance(delay);
             execAddressError(addr, false);
             return true;
         }
@@ -374,7 +733,7 @@ Moira::prefetch()
 {
     if (EMULATE_FC) fcl = 2;
     queue.ird = queue.irc;
-    queue.irc = readM<Word,last>(reg.pc + 2);
+    queue.irc = readP<last>(reg.pc + 2);
 }
 
 template<bool last> void
@@ -383,7 +742,7 @@ Moira::fullPrefetch()
     if (EMULATE_FC) fcl = 2;
     if (addressReadError<Word,2>(reg.pc)) return;
 
-    queue.irc = readM<Word>(reg.pc);
+    queue.irc = readP(reg.pc);
     prefetch<last>();
 }
 
@@ -394,17 +753,40 @@ Moira::readExt()
     if (!skip) {
         if (EMULATE_FC) fcl = 2;
         if (addressReadError<Word>(reg.pc)) return;
-        queue.irc = readM<Word>(reg.pc);
+        queue.irc = readP(reg.pc);
     }
 }
 
+#ifndef MOIRA_HANDLERS_ONLY
+
 void
 Moira::jumpToVector(int nr)
 {
     if (EMULATE_FC) fcl = 1;
     
-    // Update the program counter
-    reg.pc = readM<Long>(4 * nr);
+    // Update the program counter (arbitrated reads can't be skipped)
+    if (cacheVectors && !(flags & (CPU_CHECK_WP | CPU_ARBITRATE))) {
+
+        if (!vectorCached[nr]) {
+
+            // Writes are matched against the physical vector table
+            if (EMULATE_MMU) vectorBase = translation ? translateAddr(0) : 0;
+
+            vectors[nr] = readM<Long>(4 * nr);
+            vectorCached[nr] = true;
+
+        } else {
+
+            // Charge both bus cycles including the wait states
+            u32 addr = (EMULATE_MMU && translation) ? translateAddr(4 * nr) : 4 * nr;
+            advance(8 + pageOf(addr).wait + pageOf(addr + 2).wait);
+        }
+        reg.pc = vectors[nr];
+
+    } else {
+
+        reg.pc = readM<Long>(4 * nr);
+    }
 
     // Align the exception pointer to an even address
     // Note: This is almost certainly wrong.
@@ -412,7 +794,9 @@ Moira::jumpToVector(int nr)
     if (!MIMIC_MUSASHI) reg.pc &= ~1;
     
     // Update the prefetch queue
-    queue.ird = readM<Word>(reg.pc);
-    sync(2);
-    queue.irc = readM<Word,LAST_BUS_CYCLE>(reg.pc + 2);
+    queue.ird = readP(reg.pc);
+    advance(2);
+    queue.irc = readP<LAST_BUS_CYCLE>(reg.pc + 2);
 }
+
+#endif
@@ -178,6 +178,7 @@ Debugger::stepInto()
     breakpoints.setNeedsCheck(true);
 }
 
+#if MOIRA_DASM
 void
 Debugger::stepOver()
 {
@@ -185,6 +186,7 @@ Debugger::stepOver()
     softStop = moira.getPC() + moira.disassemble(moira.getPC(), tmp);
     breakpoints.setNeedsCheck(true);
 }
+#endif
 
 bool
 Debugger::breakpointMatches(u32 addr)
@@ -211,6 +213,7 @@ Debugger::watchpointMatches(u32 addr)
 void
 Debugger::enableLogging()
 {
+    if (!logBuffer) logBuffer.reset(new Registers[logBufferCapacity]);
     moira.flags |= Moira::CPU_LOG_INSTRUCTION;
 }
 
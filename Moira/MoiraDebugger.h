@@ -10,6 +10,8 @@
 #ifndef MOIRA_GUARD_H
 #define MOIRA_GUARD_H
 
+#include <memory>
+
 namespace moira {
 
 struct Guard {
@@ -153,9 +155,9 @@ private:
      */
     u64 softStop = UINT64_MAX - 1;
 
-    // Buffer storing logged instructions
+    // Buffer storing logged instructions (allocated when logging is enabled)
     static const int logBufferCapacity = 256;
-    Registers logBuffer[logBufferCapacity];
+    std::unique_ptr<Registers[]> logBuffer;
 
     // Logging counter
     long logCnt = 0;
@@ -178,8 +180,10 @@ public:
     // Sets a soft breakpoint that will trigger immediately
     void stepInto();
 
-    // Sets a soft breakpoint to the next instruction
+#if MOIRA_DASM
+    // Sets a soft breakpoint to the next instruction (uses the disassembler)
     void stepOver();
+#endif
 
     // Returns true if a breakpoint hits at the provides address
     bool breakpointMatches(u32 addr);
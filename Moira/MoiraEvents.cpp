@@ -0,0 +1,91 @@
+// -----------------------------------------------------------------------------
+// This file is part of Moira - A Motorola 68k emulator
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "Moira.h"
+#include <assert.h>
+
+namespace moira {
+
+bool
+EventQueue::before(const Event &e1, const Event &e2)
+{
+    return e1.cycle < e2.cycle || (e1.cycle == e2.cycle && e1.stamp < e2.stamp);
+}
+
+void
+EventQueue::clear()
+{
+    heap.clear();
+    moira.trigger = INT64_MAX;
+}
+
+void
+EventQueue::schedule(i64 cycle, EventType type, i64 data)
+{
+    // Append the event and let it bubble up
+    Event event = Event { cycle, stamps++, type, data };
+    heap.push_back(event);
+
+    long i = (long)heap.size() - 1;
+    while (i > 0) {
+
+        long parent = (i - 1) / 2;
+        if (!before(event, heap[parent])) break;
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = event;
+    moira.trigger = heap[0].cycle;
+}
+
+Event
+EventQueue::pop()
+{
+    assert(!heap.empty());
+
+    Event result = heap[0];
+    Event last = heap.back();
+    heap.pop_back();
+
+    if (heap.empty()) { moira.trigger = INT64_MAX; return result; }
+
+    // Move the last element to the top and let it sink down
+    long count = (long)heap.size();
+    long i = 0;
+    while (2 * i + 1 < count) {
+
+        long child = 2 * i + 1;
+        if (child + 1 < count && before(heap[child + 1], heap[child])) child++;
+        if (!before(heap[child], last)) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = last;
+    moira.trigger = heap[0].cycle;
+
+    return result;
+}
+
+void
+EventQueue::serve(i64 cycle)
+{
+    // Note: The callback may schedule new events which are served, too
+    while (moira.trigger <= cycle) {
+
+        Event event = pop();
+
+        switch (event.type) {
+
+            case EVENT_IPL:      moira.setIPL((u8)event.data); break;
+            case EVENT_CALLBACK: moira.eventTriggered(event.data); break;
+        }
+    }
+}
+
+}
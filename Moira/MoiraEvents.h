@@ -0,0 +1,104 @@
+// -----------------------------------------------------------------------------
+// This file is part of Moira - A Motorola 68k emulator
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#ifndef MOIRA_EVENTS_H
+#define MOIRA_EVENTS_H
+
+#include "MoiraTypes.h"
+#include <vector>
+
+namespace moira {
+
+typedef enum
+{
+    EVENT_IPL,       // Changes the value on the IPL pins
+    EVENT_CALLBACK   // Calls eventTriggered() with a host-defined id
+}
+EventType;
+
+struct Event {
+
+    // The cycle at which the event triggers
+    i64 cycle;
+
+    // Insertion stamp (keeps events with the same trigger cycle in order)
+    u64 stamp;
+
+    // Type of this event
+    EventType type;
+
+    // Payload (the new IPL value or the id passed to the callback)
+    i64 data;
+};
+
+class EventQueue {
+
+    friend class Moira;
+
+protected:
+
+    // Reference to the connected CPU
+    class Moira &moira;
+
+    // Binary min-heap holding all scheduled events
+    std::vector<Event> heap;
+
+    // Number of events that have been scheduled so far
+    u64 stamps = 0;
+
+
+    //
+    // Constructing and destructing
+    //
+
+public:
+
+    EventQueue(Moira& ref) : moira(ref) { heap.reserve(16); }
+
+
+    //
+    // Inspecting the queue
+    //
+
+    long elements() { return (long)heap.size(); }
+    bool isEmpty() { return heap.empty(); }
+
+
+    //
+    // Scheduling events
+    //
+
+    // Changes the IPL pins to 'level' when the CPU clock reaches 'cycle'
+    void scheduleIPL(i64 cycle, u8 level) { schedule(cycle, EVENT_IPL, level); }
+
+    // Calls eventTriggered(id) when the CPU clock reaches 'cycle'
+    void scheduleCallback(i64 cycle, i64 id) { schedule(cycle, EVENT_CALLBACK, id); }
+
+    // Removes all scheduled events
+    void clear();
+
+private:
+
+    void schedule(i64 cycle, EventType type, i64 data);
+
+
+    //
+    // Processing events
+    //
+
+    // Processes all events with a trigger cycle less or equal to 'cycle'
+    void serve(i64 cycle);
+
+    // Maintains the heap property
+    bool before(const Event &e1, const Event &e2);
+    Event pop();
+};
+
+}
+#endif
@@ -7,6 +7,18 @@
 // See https://www.gnu.org for license information
 // -----------------------------------------------------------------------------
 
+/* Returns the addressing mode of an instruction handler
+ * In compact builds, the handlers of rarely used instructions are only
+ * instantiated with MODE_IP. They look up the real mode in the info table.
+ */
+template<Mode M> Mode modeOf(u16 opcode) { return M == MODE_IP ? info[opcode].M : M; }
+
+// Saves the status register and enters supervisor mode
+u16 enterException();
+
+// Clears the T flag and discards a pending trace exception
+void disableTracing() { clearTraceFlag(); flags &= ~CPU_TRACE_EXCEPTION; }
+
 // Saves information to stack for group 0 exceptions
 void saveToStackDetailed(u16 sr, u32 addr, u16 code);
 
@@ -0,0 +1,39 @@
+// -----------------------------------------------------------------------------
+// This file is part of Moira - A Motorola 68k emulator
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <assert.h>
+#include <algorithm>
+#include <string.h>
+
+#include "Moira.h"
+#include "MoiraConfig.h"
+
+// All functions but the instruction handlers are compiled in Moira.cpp
+#define MOIRA_HANDLERS_ONLY
+
+namespace moira {
+
+#include "MoiraInit_cpp.h"
+#include "MoiraALU_cpp.h"
+#include "MoiraDataflow_cpp.h"
+#include "MoiraExec_cpp.h"
+
+#define bind(id, name, I, M, S) bindExec(id, name, I, M, S)
+#define MOIRA_PART 2
+
+void
+Moira::createExecTables2()
+{
+    u16 opcode;
+
+    #include "MoiraTables_cpp.h"
+}
+
+}
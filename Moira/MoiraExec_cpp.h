@@ -27,9 +27,32 @@
 #define ____x___________(opcode) (u16)((opcode >> 11) & 0b1)
 #define xxxx____________(opcode) (u16)((opcode >> 12) & 0b1111)
 
+#ifndef MOIRA_HANDLERS_ONLY
+
+u16
+Moira::enterException()
+{
+    u16 status = getSR();
+
+    // Recover from stop state
+    flags &= ~CPU_IS_STOPPED;
+
+    // Enter supervisor mode
+    setSupervisorMode(true);
+
+    return status;
+}
+
 void
 Moira::saveToStackDetailed(u16 sr, u32 addr, u16 code)
 {
+    u16 frame[7] = {
+        code, (u16)(addr >> 16), (u16)addr, queue.ird, sr, (u16)(reg.pc >> 16), (u16)reg.pc
+    };
+
+    // Write the frame in a single step if the stack is directly mapped
+    if (writeMDirect(reg.sp - 14, frame, 7)) { reg.sp -= 14; return; }
+
     // Push PC
     push<Word>((u16)reg.pc);
     push<Word>(reg.pc >> 16);
@@ -49,6 +72,11 @@ Moira::saveToStackDetailed(u16 sr, u32 addr, u16 code)
 void
 Moira::saveToStackBrief(u16 sr, u32 pc)
 {
+    u16 frame[3] = { sr, (u16)(pc >> 16), (u16)pc };
+
+    // Write the frame in a single step if the stack is directly mapped
+    if (writeMDirect(reg.sp - 6, frame, 3)) { reg.sp -= 6; return; }
+
     if (MIMIC_MUSASHI) {
 
         push<Long>(pc);
@@ -68,21 +96,18 @@ Moira::execAddressError(u32 addr, bool read)
 {
     assert(addr & 1);
 
-    u16 status = getSR();
-
     // Memory access type and function code
     u16 code = (queue.ird & 0xFFE0) | readFC();
     if (read) code |= 0x10;
 
-    // Enter supervisor mode and update the status register
-    setSupervisorMode(true);
-    clearTraceFlag();
-    flags &= ~CPU_TRACE_EXCEPTION;
+    // Enter supervisor mode and disable tracing
+    u16 status = enterException();
+    disableTracing();
 
     // Write exception information to stack
-    sync(8);
+    advance(8);
     saveToStackDetailed(status, addr, code);
-    sync(2);
+    advance(2);
 
     jumpToVector(3);
 }
@@ -90,14 +115,12 @@ Moira::execAddressError(u32 addr, bool read)
 void
 Moira::execUnimplemented(int nr)
 {
-    u16 status = getSR();
+    // Enter supervisor mode and disable tracing
+    u16 status = enterException();
+    disableTracing();
 
-    // Enter supervisor mode and update the status register
-    setSupervisorMode(true);
-    clearTraceFlag();
-    flags &= ~CPU_TRACE_EXCEPTION;
-
-    sync(4);
+    // Write exception information to stack
+    advance(4);
     saveToStackBrief(status, reg.pc - 2);
 
     jumpToVector(nr);
@@ -118,39 +141,18 @@ Moira::execLineF(u16 opcode)
 void
 Moira::execIllegal(u16 opcode)
 {
-    u16 status = getSR();
-
-    // Enter supervisor mode
-    setSupervisorMode(true);
-
-    // Disable tracing
-    clearTraceFlag();
-    flags &= ~CPU_TRACE_EXCEPTION;
-
-    // Write exception information to stack
-    sync(4);
-    saveToStackBrief(status, reg.pc - 2);
-
-    jumpToVector(4);
+    execUnimplemented(4);
 }
 
 void
 Moira::execTraceException()
 {
-    u16 status = getSR();
-
-    // Recover from stop state
-    flags &= ~CPU_IS_STOPPED;
-
-    // Enter supervisor mode
-    setSupervisorMode(true);
-
-    // Disable tracing
-    clearTraceFlag();
-    flags &= ~CPU_TRACE_EXCEPTION;
+    // Enter supervisor mode and disable tracing
+    u16 status = enterException();
+    disableTracing();
 
     // Write exception information to stack
-    sync(4);
+    advance(4);
     saveToStackBrief(status, reg.pc);
 
     jumpToVector(9);
@@ -159,14 +161,8 @@ Moira::execTraceException()
 void
 Moira::execTrapException(int nr)
 {
-    u16 status = getSR();
-
-    // Enter supervisor mode
-    setSupervisorMode(true);
-
-    // Disable tracing
-    // clearTraceFlag();
-    // flags &= ~CPU_TRACE_EXCEPTION;
+    // Enter supervisor mode (tracing stays enabled)
+    u16 status = enterException();
 
     // Write exception information to stack
     saveToStackBrief(status);
@@ -177,19 +173,14 @@ Moira::execTrapException(int nr)
 void
 Moira::execPrivilegeException()
 {
-    u16 status = getSR();
-
-    // Enter supervisor mode
-    setSupervisorMode(true);
-
-    // Disable tracing
-    clearTraceFlag();
-    flags &= ~CPU_TRACE_EXCEPTION;
+    // Enter supervisor mode and disable tracing
+    u16 status = enterException();
+    disableTracing();
 
     reg.pc -= 2;
 
     // Write exception information to stack
-    sync(4);
+    advance(4);
     saveToStackBrief(status);
 
     jumpToVector(8);
@@ -200,35 +191,37 @@ Moira::execIrqException(int level)
 {
     assert(level < 8);
 
-    // Remember the current value of the status register
-    u16 status = getSR();
-
-    // Recover from stop state
-    flags &= ~CPU_IS_STOPPED;
-
     // Clear the polled IPL value
     reg.ipl = 0;
 
-    // Tempararily raise the interrupt threshold
-    reg.sr.ipl = level;
-
     // Enter supervisor mode and update the status register
-    setSupervisorMode(true);
+    u16 status = enterException();
     clearTraceFlag();
 
-    sync(6);
+    // Tempararily raise the interrupt threshold
+    reg.sr.ipl = level;
+
+    advance(6);
     reg.sp -= 6;
-    writeM<Word>(reg.sp + 4, reg.pc & 0xFFFF);
+
+    u16 frame[3] = { status, (u16)(reg.pc >> 16), (u16)reg.pc };
+    if (!writeMDirect(reg.sp + 4, frame + 2, 1)) {
+        writeM<Word>(reg.sp + 4, frame[2]);
+    }
 
     u8 vector = getIrqVector(level);
 
-    sync(4);
-    writeM<Word>(reg.sp + 0, status);
-    writeM<Word>(reg.sp + 2, reg.pc >> 16);
+    advance(4);
+    if (!writeMDirect(reg.sp + 0, frame, 2)) {
+        writeM<Word>(reg.sp + 0, frame[0]);
+        writeM<Word>(reg.sp + 2, frame[1]);
+    }
 
     jumpToVector(vector);
 }
 
+#endif
+
 template<Instr I, Mode M, Size S> void
 Moira::execShiftRg(u16 opcode)
 {
@@ -237,7 +230,7 @@ Moira::execShiftRg(u16 opcode)
     int cnt = readD(src) & 0x3F;
 
     prefetch<LAST_BUS_CYCLE>();
-    sync((S == Long ? 4 : 2) + 2 * cnt);
+    advance((S == Long ? 4 : 2) + 2 * cnt);
 
     writeD<S>(dst, shift<I,S>(cnt, readD<S>(dst)));
 }
@@ -250,7 +243,7 @@ Moira::execShiftIm(u16 opcode)
     int cnt = src ? src : 8;
 
     prefetch<LAST_BUS_CYCLE>();
-    sync((S == Long ? 4 : 2) + 2 * cnt);
+    advance((S == Long ? 4 : 2) + 2 * cnt);
 
     writeD<S>(dst, shift<I,S>(cnt, readD<S>(dst)));
 }
@@ -274,23 +267,23 @@ Moira::execAbcd(u16 opcode)
     int src = _____________xxx(opcode);
     int dst = ____xxx_________(opcode);
 
-    switch (M) {
+    switch (modeOf<M>(opcode)) {
 
         case 0: // Dn
         {
             u32 result = bcd<I,Byte>(readD<Byte>(src), readD<Byte>(dst));
             prefetch<LAST_BUS_CYCLE>();
 
-            sync(S == Long ? 6 : 2);
+            advance(S == Long ? 6 : 2);
             writeD<Byte>(dst, result);
             break;
         }
         default: // Ea
         {
             u32 ea1, ea2, data1, data2;
-            if (!readOp<M,S>(src, ea1, data1)) return;
-            sync(-2);
-            if (!readOp<M,S>(dst, ea2, data2)) return;
+            if (!readOp<S>(modeOf<M>(opcode), src, ea1, data1)) return;
+            advance(-2);
+            if (!readOp<S>(modeOf<M>(opcode), dst, ea2, data2)) return;
 
             u32 result = bcd<I,Byte>(data1, data2);
             prefetch();
@@ -314,7 +307,7 @@ Moira::execAddEaRg(u16 opcode)
     result = addsub<I,S>(data, readD<S>(dst));
     prefetch<LAST_BUS_CYCLE>();
 
-    if (S == Long) sync(2 + (isMemMode(M) ? 0 : 2));
+    if (S == Long) advance(2 + (isMemMode(M) ? 0 : 2));
     writeD<S>(dst, result);
 }
 
@@ -347,8 +340,8 @@ Moira::execAdda(u16 opcode)
     result = (I == ADDA) ? readA(dst) + data : readA(dst) - data;
     prefetch<LAST_BUS_CYCLE>();
 
-    sync(2);
-    if (S == Word || isRegMode(M) || isImmMode(M)) sync(2);
+    advance(2);
+    if (S == Word || isRegMode(M) || isImmMode(M)) advance(2);
     writeA(dst, result);
 }
 
@@ -364,7 +357,7 @@ Moira::execAddiRg(u16 opcode)
     result = addsub<I,S>(src, data);
     prefetch<LAST_BUS_CYCLE>();
 
-    if (S == Long) sync(4);
+    if (S == Long) advance(4);
     writeD<S>(dst, result);
 }
 
@@ -393,7 +386,7 @@ Moira::execAddqDn(u16 opcode)
     u32 result = addsub<I,S>(src, readD<S>(dst));
     prefetch<LAST_BUS_CYCLE>();
 
-    if (S == Long) sync(4);
+    if (S == Long) advance(4);
     writeD<S>(dst, result);
 }
 
@@ -407,7 +400,7 @@ Moira::execAddqAn(u16 opcode)
     u32 result = (I == ADDQ) ? readA(dst) + src : readA(dst) - src;
     prefetch<LAST_BUS_CYCLE>();
 
-    sync(4);
+    advance(4);
     writeA(dst, result);
 }
 
@@ -436,7 +429,7 @@ Moira::execAddxRg(u16 opcode)
     u32 result = addsub<I,S>(readD<S>(src), readD<S>(dst));
     prefetch<LAST_BUS_CYCLE>();
 
-    if (S == Long) sync(4);
+    if (S == Long) advance(4);
     writeD<S>(dst, result);
 }
 
@@ -448,7 +441,7 @@ Moira::execAddxEa(u16 opcode)
 
     u32 ea1, ea2, data1, data2;
     if (!readOp<M,S>(src, ea1, data1)) return;
-    sync(-2);
+    advance(-2);
     if (!readOp<M,S>(dst, ea2, data2)) return;
 
     u32 result = addsub<I,S>(data1, data2);
@@ -476,7 +469,7 @@ Moira::execAndEaRg(u16 opcode)
     u32 result = logic<I,S>(data, readD<S>(dst));
     prefetch<LAST_BUS_CYCLE>();
 
-    if (S == Long) sync(isRegMode(M) || isImmMode(M) ? 4 : 2);
+    if (S == Long) advance(isRegMode(M) || isImmMode(M) ? 4 : 2);
     writeD<S>(dst, result);
 }
 
@@ -492,7 +485,7 @@ Moira::execAndRgEa(u16 opcode)
     u32 result = logic<I,S>(readD<S>(src), data);
     isMemMode(M) ? prefetch() : prefetch<LAST_BUS_CYCLE>();
 
-    if (S == Long && isRegMode(M)) sync(4);
+    if (S == Long && isRegMode(M)) advance(4);
     writeOp<M,S,LAST_BUS_CYCLE>(dst, ea, result);
 }
 
@@ -505,7 +498,7 @@ Moira::execAndiRg(u16 opcode)
     u32 result = logic<I,S>(src, readD<S>(dst));
     prefetch<LAST_BUS_CYCLE>();
 
-    if (S == Long) sync(4);
+    if (S == Long) advance(4);
     writeD<S>(dst, result);
 }
 
@@ -531,7 +524,7 @@ Moira::execAndiccr(u16 opcode)
     u32 src = readI<S>();
     u8  dst = getCCR();
 
-    sync(8);
+    advance(8);
 
     u32 result = logic<I,S>(src, dst);
     setCCR(result);
@@ -548,7 +541,7 @@ Moira::execAndisr(u16 opcode)
     u32 src = readI<S>();
     u16 dst = getSR();
 
-    sync(8);
+    advance(8);
 
     u32 result = logic<I,S>(src, dst);
     setSR(result);
@@ -560,11 +553,14 @@ Moira::execAndisr(u16 opcode)
 template<Instr I, Mode M, Size S> void
 Moira::execBcc(u16 opcode)
 {
-    sync(2);
+    advance(2);
     if (cond<I>()) {
 
         u32 newpc = reg.pc + (S == Word ? (i16)queue.irc : (i8)opcode);
 
+        // Check for an idle loop
+        if (detectIdleLoops && newpc < reg.pc) checkIdleLoop(reg.pc - 2, newpc);
+
         // Take branch
         reg.pc = newpc;
         fullPrefetch<LAST_BUS_CYCLE>();
@@ -572,7 +568,7 @@ Moira::execBcc(u16 opcode)
     } else {
 
         // Fall through to next instruction
-        sync(2);
+        advance(2);
         if (S == Word) readExt();
         prefetch<LAST_BUS_CYCLE>();
     }
@@ -594,7 +590,7 @@ Moira::execBitDxEa(u16 opcode)
 
             prefetch<LAST_BUS_CYCLE>();
 
-            sync(cyclesBit<I>(b));
+            advance(cyclesBit<I>(b));
             if (I != BTST) writeD(dst, data);
             break;
         }
@@ -633,7 +629,7 @@ Moira::execBitImEa(u16 opcode)
 
             prefetch<LAST_BUS_CYCLE>();
 
-            sync(cyclesBit<I>(src));
+            advance(cyclesBit<I>(src));
             if (I != BTST) writeD(dst, data);
             break;
         }
@@ -663,7 +659,7 @@ Moira::execBsr(u16 opcode)
     u32 retpc = reg.pc + (S == Word ? 2 : 0);
 
     // Save the return address
-    sync(2);
+    advance(2);
     push<Long>(retpc);
 
     // Take branch
@@ -679,13 +675,13 @@ Moira::execChk(u16 opcode)
     int src = _____________xxx(opcode);
     int dst = ____xxx_________(opcode);
 
-    i64 c = clock;
+    i64 c = now();
     u32 ea, data, dy;
-    if (!readOp<M,S>(src, ea, data)) return;
+    if (!readOp<S>(modeOf<M>(opcode), src, ea, data)) return;
     dy = readD<S>(dst);
 
     prefetch<LAST_BUS_CYCLE>();
-    sync(4);
+    advance(4);
 
     reg.sr.z = ZERO<S>(dy);
     reg.sr.v = 0;
@@ -694,17 +690,17 @@ Moira::execChk(u16 opcode)
 
     if ((i16)dy > (i16)data) {
 
-        sync(MIMIC_MUSASHI ? 10 - (int)(clock - c) : 0);
+        advance(MIMIC_MUSASHI ? 10 - (int)(now() - c) : 0);
         reg.sr.n = NBIT<S>(dy);
         execTrapException(6);
         return;
     }
 
-    if (MIMIC_MUSASHI) sync(2);
+    if (MIMIC_MUSASHI) advance(2);
     
     if ((i16)dy < 0) {
 
-        sync(MIMIC_MUSASHI ? 10 - (int)(clock - c) : 0);
+        advance(MIMIC_MUSASHI ? 10 - (int)(now() - c) : 0);
         reg.sr.n = MIMIC_MUSASHI ? NBIT<S>(dy) : 1;
         execTrapException(6);
     }
@@ -720,7 +716,7 @@ Moira::execClr(u16 opcode)
 
     isMemMode(M) ? prefetch() : prefetch<LAST_BUS_CYCLE>();
 
-    if (S == Long && isRegMode(M)) sync(2);
+    if (S == Long && isRegMode(M)) advance(2);
     writeOp<M,S,LAST_BUS_CYCLE>(dst, ea, 0);
 
     reg.sr.n = 0;
@@ -741,7 +737,7 @@ Moira::execCmp(u16 opcode)
     cmp<S>(data, readD<S>(dst));
     prefetch<LAST_BUS_CYCLE>();
 
-    if (S == Long) sync(2);
+    if (S == Long) advance(2);
 }
 
 template<Instr I, Mode M, Size S> void
@@ -757,7 +753,7 @@ Moira::execCmpa(u16 opcode)
     cmp<Long>(data, readA(dst));
     prefetch<LAST_BUS_CYCLE>();
 
-    sync(2);
+    advance(2);
 }
 
 template<Instr I, Mode M, Size S> void
@@ -768,7 +764,7 @@ Moira::execCmpiRg(u16 opcode)
 
     prefetch<LAST_BUS_CYCLE>();
 
-    if (S == Long) sync(2);
+    if (S == Long) advance(2);
     cmp<S>(src, readD<S>(dst));
 }
 
@@ -803,11 +799,14 @@ Moira::execCmpm(u16 opcode)
 template<Instr I, Mode M, Size S> void
 Moira::execDbcc(u16 opcode)
 {
-    sync(2);
+    i64 c = now();
+
+    advance(2);
     if (!cond<I>()) {
 
         int dn = _____________xxx(opcode);
         u32 newpc = reg.pc + (i16)queue.irc;
+        bool self = newpc == reg.pc - 2;
 
         // Decrement loop counter
         writeD<Word>(dn, readD<Word>(dn) - 1);
@@ -817,12 +816,15 @@ Moira::execDbcc(u16 opcode)
 
             reg.pc = newpc;
             fullPrefetch<LAST_BUS_CYCLE>();
+
+            // Fast-forward delay loops of the form "DBcc Dn,*"
+            if (self && skipDelayLoops) skipDelayLoop(dn, now() - c);
             return;
         } else {
             (void)readM<Word>(reg.pc + 2);
         }
     } else {
-        sync(2);
+        advance(2);
     }
 
     // Fall through to next instruction
@@ -839,7 +841,7 @@ Moira::execExgDxDy(u16 opcode)
     std::swap(reg.d[src], reg.d[dst]);
     prefetch<LAST_BUS_CYCLE>();
 
-    sync(2);
+    advance(2);
 }
 
 template<Instr I, Mode M, Size S> void
@@ -851,7 +853,7 @@ Moira::execExgAxDy(u16 opcode)
     std::swap(reg.a[src], reg.d[dst]);
 
     prefetch<LAST_BUS_CYCLE>();
-    sync(2);
+    advance(2);
 }
 
 template<Instr I, Mode M, Size S> void
@@ -863,7 +865,7 @@ Moira::execExgAxAy(u16 opcode)
     std::swap(reg.a[src], reg.a[dst]);
 
     prefetch<LAST_BUS_CYCLE>();
-    sync(2);
+    advance(2);
 }
 
 template<Instr I, Mode M, Size S> void
@@ -890,7 +892,7 @@ Moira::execJmp(u16 opcode)
     u32 ea  = computeEA <M,Long,true /* skip last read */> (src);
 
     const int delay[] = { 0,0,0,0,0,2,4,2,0,2,4,0 };
-    sync(delay[M]);
+    advance(delay[M]);
 
     // Jump to new address
     reg.pc = ea;
@@ -906,14 +908,14 @@ Moira::execJsr(u16 opcode)
     u32 ea  = computeEA <M,Long, true /* skip last read */> (src);
 
     const int delay[] = { 0,0,0,0,0,2,4,2,0,2,4,0 };
-    sync(delay[M]);
+    advance(delay[M]);
 
     // Jump to new address
     u32 oldpc = reg.pc;
     reg.pc = ea;
 
     if (addressReadError<Word>(ea)) return;
-    queue.irc = readM<Word>(ea);
+    queue.irc = readP(ea);
     push<Long>(oldpc);
     prefetch<LAST_BUS_CYCLE>();
 }
@@ -925,7 +927,7 @@ Moira::execLea(u16 opcode)
     int dst = ____xxx_________(opcode);
 
     reg.a[dst] = computeEA<M,S>(src);
-    if (isIdxMode(M)) sync(2);
+    if (isIdxMode(M)) advance(2);
 
     prefetch<LAST_BUS_CYCLE>();
 }
@@ -1031,7 +1033,7 @@ Moira::execMove4(u16 opcode)
     reg.sr.c = 0;
 
     prefetch();
-    sync(-2);
+    advance(-2);
 
     ea = computeEA<MODE_PD,S>(dst);
 
@@ -1175,11 +1177,18 @@ Moira::execMovemEaRg(u16 opcode)
 
         case 3: // (An)+
         {
-            for(int i = 0; i <= 15; i++) {
+            if (readMBlock<S>(ea, mask)) {
 
-                if (mask & (1 << i)) {
-                    writeR(i, SEXT<S>(readM<S>(ea)));
-                    ea += S;
+                for (u16 m = mask; m; m &= m - 1) ea += S;
+
+            } else {
+
+                for(int i = 0; i <= 15; i++) {
+
+                    if (mask & (1 << i)) {
+                        writeR(i, SEXT<S>(readM<S>(ea)));
+                        ea += S;
+                    }
                 }
             }
             writeA(src, ea);
@@ -1187,6 +1196,11 @@ Moira::execMovemEaRg(u16 opcode)
         }
         default:
         {
+            if (readMBlock<S>(ea, mask)) {
+
+                for (u16 m = mask; m; m &= m - 1) ea += S;
+                break;
+            }
             for(int i = 0; i <= 15; i++) {
 
                 if (mask & (1 << i)) {
@@ -1214,6 +1228,15 @@ Moira::execMovemRgEa(u16 opcode)
             u32 ea = readA(dst);
             if (mask && addressReadError<S>(ea)) return;
 
+            // Registers are stored in ascending order below the start address
+            u32 start = ea;
+            for (u16 m = mask; m; m &= m - 1) start -= S;
+            if (writeMBlock<S>(start, (u16)REVERSE_16(mask))) {
+
+                writeA(dst, start);
+                break;
+            }
+
             for(int i = 15; i >= 0; i--) {
 
                 if (mask & (0x8000 >> i)) {
@@ -1228,6 +1251,7 @@ Moira::execMovemRgEa(u16 opcode)
         {
             u32 ea = computeEA<M,S>(dst);
             if (mask && addressReadError<S>(ea)) return;
+            if (writeMBlock<S>(ea, mask)) break;
 
             for(int i = 0; i < 16; i++) {
 
@@ -1317,9 +1341,9 @@ Moira::execMoveToCcr(u16 opcode)
     int src = _____________xxx(opcode);
 
     u32 ea, data;
-    if (!readOp<M,S>(src, ea, data)) return;
+    if (!readOp<S>(modeOf<M>(opcode), src, ea, data)) return;
 
-    sync(4);
+    advance(4);
     setCCR(data);
 
     (void)readM<Word>(reg.pc + 2);
@@ -1335,7 +1359,7 @@ Moira::execMoveFromSrRg(u16 opcode)
     if (!readOp<M,S>(dst, ea, data)) return;
     prefetch<LAST_BUS_CYCLE>();
 
-    sync(2);
+    advance(2);
     writeD<S>(dst, getSR());
 }
 
@@ -1359,9 +1383,9 @@ Moira::execMoveToSr(u16 opcode)
     int src = _____________xxx(opcode);
 
     u32 ea, data;
-    if (!readOp<M,S>(src, ea, data)) return;
+    if (!readOp<S>(modeOf<M>(opcode), src, ea, data)) return;
 
-    sync(4);
+    advance(4);
     setSR(data);
 
     (void)readM<Word>(reg.pc + 2);
@@ -1422,7 +1446,7 @@ Moira::execMulMusashi(u16 op)
     prefetch<LAST_BUS_CYCLE>();
     result = mulMusashi<I>(data, readD<Word>(dst));
 
-    sync(50);
+    advance(50);
     writeD(dst, result);
 }
 
@@ -1458,7 +1482,7 @@ Moira::execDiv(u16 opcode)
             reg.sr.c = 0;
         }
 
-        sync(8);
+        advance(8);
         execTrapException(5);
         return;
     }
@@ -1475,13 +1499,13 @@ Moira::execDivMusashi(u16 opcode)
     int src = _____________xxx(opcode);
     int dst = ____xxx_________(opcode);
 
-    i64 c = clock;
+    i64 c = now();
     u32 ea, divisor, result;
     if (!readOp<M, Word>(src, ea, divisor)) return;
 
     // Check for division by zero
     if (divisor == 0) {
-        sync(8 - (int)(clock - c));
+        advance(8 - (int)(now() - c));
         execTrapException(5);
         return;
     }
@@ -1498,20 +1522,20 @@ Moira::execNbcd(u16 opcode)
 {
     int reg = _____________xxx(opcode);
 
-    switch (M) {
+    switch (modeOf<M>(opcode)) {
 
         case 0: // Dn
         {
             prefetch<LAST_BUS_CYCLE>();
 
-            sync(2);
+            advance(2);
             writeD<Byte>(reg, bcd<SBCD,Byte>(readD<Byte>(reg), 0));
             break;
         }
         default: // Ea
         {
             u32 ea, data;
-            if (!readOp<M,Byte>(reg, ea, data)) return;
+            if (!readOp<Byte>(modeOf<M>(opcode), reg, ea, data)) return;
             prefetch();
             writeM<Byte,LAST_BUS_CYCLE>(ea, bcd<SBCD,Byte>(data, 0));
             break;
@@ -1530,7 +1554,7 @@ Moira::execNegRg(u16 opcode)
     data = logic<I,S>(data);
     prefetch<LAST_BUS_CYCLE>();
 
-    if (S == Long) sync(2);
+    if (S == Long) advance(2);
     writeD<S>(dst, data);
 }
 
@@ -1561,7 +1585,7 @@ Moira::execPea(u16 opcode)
 
     u32 ea = computeEA<M,Long>(src);
 
-    if (isIdxMode(M)) sync(2);
+    if (isIdxMode(M)) advance(2);
 
     if (isAbsMode(M)) {
         push<Long>(ea);
@@ -1577,7 +1601,7 @@ Moira::execReset(u16 opcode)
 {
     SUPERVISOR_MODE_ONLY
 
-    sync(128);
+    advance(128);
     prefetch<LAST_BUS_CYCLE>();
 }
 
@@ -1640,7 +1664,7 @@ Moira::execSccRg(u16 opcode)
     data = cond<I>() ? 0xFF : 0;
     prefetch<LAST_BUS_CYCLE>();
 
-    if (data) sync(2);
+    if (data) advance(2);
     writeD<Byte>(dst, data);
 }
 
@@ -1721,7 +1745,7 @@ Moira::execTasEa(u16 opcode)
     reg.sr.c = 0;
     data |= 0x80;
 
-    if (!isRegMode(M)) sync(2);
+    if (!isRegMode(M)) advance(2);
     writeOp<M,S>(dst, ea, data);
 
     prefetch<LAST_BUS_CYCLE>();
@@ -1732,7 +1756,7 @@ Moira::execTrap(u16 opcode)
 {
     int nr = ____________xxxx(opcode);
 
-    sync(4);
+    advance(4);
     execTrapException(32 + nr);
 }
 
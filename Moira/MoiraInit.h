@@ -14,6 +14,8 @@
  *    dasmXXX : Handler for disassembling an instruction
  */
 
+#if MOIRA_DASM
+
 #define MOIRA_DECLARE_SIMPLE(x) \
 void dasm##x(StrWriter &str, u32 &addr, u16 op); \
 void exec##x(u16 op);
@@ -22,6 +24,16 @@ void exec##x(u16 op);
 template<Instr I, Mode M, Size S> void dasm##x(StrWriter &str, u32 &addr, u16 op); \
 template<Instr I, Mode M, Size S> void exec##x(u16 op);
 
+#else
+
+#define MOIRA_DECLARE_SIMPLE(x) \
+void exec##x(u16 op);
+
+#define MOIRA_DECLARE(x) \
+template<Instr I, Mode M, Size S> void exec##x(u16 op);
+
+#endif
+
 MOIRA_DECLARE_SIMPLE(LineA)
 MOIRA_DECLARE_SIMPLE(LineF)
 MOIRA_DECLARE_SIMPLE(Illegal)
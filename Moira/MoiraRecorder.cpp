@@ -0,0 +1,154 @@
+// -----------------------------------------------------------------------------
+// This file is part of Moira - A Motorola 68k emulator
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "MoiraRecorder.h"
+#include <string.h>
+
+namespace moira {
+
+static const char magic[8] = { 'M', 'O', 'I', 'R', 'A', 'B', 'U', 'S' };
+static const u32 version = 1;
+
+// Size of a serialized record in bytes
+static const int recordSize = 16;
+
+static void put(u8 *&p, u64 value, int bytes)
+{
+    for (int i = 0; i < bytes; i++) *p++ = (u8)(value >> (8 * i));
+}
+
+static u64 get(const u8 *&p, int bytes)
+{
+    u64 result = 0;
+    for (int i = 0; i < bytes; i++) result |= (u64)*p++ << (8 * i);
+    return result;
+}
+
+void
+BusRecorder::clear()
+{
+    // Allocated chunks are kept for reuse
+    count = 0;
+}
+
+void
+BusRecorder::record(BusAccess type, u32 addr, u16 value, i64 cycle, u8 fc)
+{
+    if (count / chunkSize == (long)chunks.size()) {
+        chunks.push_back(std::unique_ptr<BusRecord[]>(new BusRecord[chunkSize]));
+    }
+
+    chunks[count / chunkSize][count % chunkSize] = BusRecord { cycle, addr, value, (u8)type, fc };
+    count++;
+}
+
+bool
+BusRecorder::save(FILE *file) const
+{
+    u8 header[20], *p = header + 8;
+
+    memcpy(header, magic, 8);
+    put(p, version, 4);
+    put(p, (u64)count, 8);
+    if (fwrite(header, 1, sizeof(header), file) != sizeof(header)) return false;
+
+    for (long i = 0; i < count; i++) {
+
+        const BusRecord &r = (*this)[i];
+        u8 buffer[recordSize], *p = buffer;
+
+        put(p, (u64)r.cycle, 8);
+        put(p, r.addr, 4);
+        put(p, r.value, 2);
+        put(p, r.type, 1);
+        put(p, r.fc, 1);
+        if (fwrite(buffer, 1, recordSize, file) != recordSize) return false;
+    }
+    return true;
+}
+
+bool
+BusRecorder::load(FILE *file)
+{
+    u8 header[20];
+    const u8 *p = header + 8;
+
+    clear();
+
+    if (fread(header, 1, sizeof(header), file) != sizeof(header)) return false;
+    if (memcmp(header, magic, 8) != 0) return false;
+    if (get(p, 4) != version) return false;
+    u64 total = get(p, 8);
+
+    for (u64 i = 0; i < total; i++) {
+
+        u8 buffer[recordSize];
+        const u8 *p = buffer;
+        if (fread(buffer, 1, recordSize, file) != recordSize) { clear(); return false; }
+
+        i64 cycle = (i64)get(p, 8);
+        u32 addr = (u32)get(p, 4);
+        u16 value = (u16)get(p, 2);
+        u8 type = (u8)get(p, 1);
+        u8 fc = (u8)get(p, 1);
+        if (type > BUS_POLL) { clear(); return false; }
+
+        record((BusAccess)type, addr, value, cycle, fc);
+    }
+    return true;
+}
+
+const BusRecord *
+BusReplayer::match(BusAccess type, u32 addr, u8 fc)
+{
+    const BusRecord *r = peekNext();
+
+    if (r && r->type == type && r->addr == addr && r->fc == fc) {
+        next++;
+        return r;
+    }
+    mismatches++;
+    return nullptr;
+}
+
+u16
+BusReplayer::read(BusAccess type, u32 addr, u8 fc)
+{
+    const BusRecord *r = match(type, addr, fc);
+    return r ? r->value : 0;
+}
+
+u16
+BusReplayer::read(BusAccess type, u32 addr, u8 fc, i64 cycle)
+{
+    const BusRecord *r = peekNext();
+
+    if (r && r->cycle != cycle) { mismatches++; return 0; }
+    return read(type, addr, fc);
+}
+
+bool
+BusReplayer::write(BusAccess type, u32 addr, u16 value, u8 fc)
+{
+    const BusRecord *r = peekNext();
+
+    if (r && r->value != value) { mismatches++; return false; }
+    return match(type, addr, fc) != nullptr;
+}
+
+bool
+BusReplayer::write(BusAccess type, u32 addr, u16 value, u8 fc, i64 cycle)
+{
+    const BusRecord *r = peekNext();
+
+    if (r && r->cycle != cycle) { mismatches++; return false; }
+    return write(type, addr, value, fc);
+}
+
+}
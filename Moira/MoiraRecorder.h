@@ -0,0 +1,137 @@
+// -----------------------------------------------------------------------------
+// This file is part of Moira - A Motorola 68k emulator
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#ifndef MOIRA_RECORDER_H
+#define MOIRA_RECORDER_H
+
+#include "MoiraTypes.h"
+#include <stdio.h>
+#include <memory>
+#include <vector>
+
+namespace moira {
+
+typedef enum
+{
+    BUS_PEEK8,       // Byte read
+    BUS_PEEK16,      // Word read
+    BUS_POKE8,       // Byte write
+    BUS_POKE16,      // Word write
+    BUS_POLL         // IPL poll or other host-defined access
+}
+BusAccess;
+
+struct BusRecord {
+
+    i64 cycle;       // CPU clock at the time of the access
+    u32 addr;        // Accessed address
+    u16 value;       // Read or written value
+    u8 type;         // Access type (BusAccess)
+    u8 fc;           // Value on the function code pins
+};
+
+/* Records bus accesses.
+ *
+ * The host calls record() from its bus functions. The records are stored in
+ * fixed-size chunks. Hence, the recorder can grow without bounds and
+ * never moves existing records. Each record is addressed by its sequence
+ * number.
+ */
+class BusRecorder {
+
+    static const long chunkSize = 4096;
+
+protected:
+
+    // Storage
+    std::vector<std::unique_ptr<BusRecord[]>> chunks;
+
+    // Number of recorded accesses
+    long count = 0;
+
+public:
+
+    // Deletes all records
+    void clear();
+
+    // Returns the number of recorded accesses
+    long size() const { return count; }
+
+    // Records an access
+    void record(BusAccess type, u32 addr, u16 value, i64 cycle, u8 fc = 0);
+
+    // Returns the record with the given sequence number
+    const BusRecord &operator[](long nr) const {
+        return chunks[nr / chunkSize][nr % chunkSize];
+    }
+
+    /* Saves or loads a recording in binary format.
+     * All values are stored in little endian byte order. The functions
+     * return false if an I/O error occurs or the file format is invalid.
+     */
+    bool save(FILE *file) const;
+    bool load(FILE *file);
+};
+
+/* Replays a recording.
+ *
+ * The replayer walks through the recording in order and feeds the recorded
+ * read values back to the host. Each lookup is performed in constant time.
+ * An access that doesn't match the recording is reported as a mismatch.
+ * Besides the type, address, and value, the function code must match. The
+ * cycle is only checked if the host passes one in.
+ */
+class BusReplayer {
+
+protected:
+
+    // The replayed recording
+    const BusRecorder &recording;
+
+    // Sequence number of the next expected access
+    long next = 0;
+
+    // Number of accesses that didn't match the recording
+    long mismatches = 0;
+
+public:
+
+    BusReplayer(const BusRecorder &ref) : recording(ref) { }
+
+    // Restarts the replay at the given sequence number
+    void rewind(long nr = 0) { next = nr; mismatches = 0; }
+
+    // Returns the sequence number of the next expected access
+    long position() const { return next; }
+
+    // Indicates if all records have been replayed
+    bool atEnd() const { return next >= recording.size(); }
+
+    // Returns the number of mismatches since the last rewind
+    long getMismatches() const { return mismatches; }
+
+    // Returns the record of the next expected access (NULL if at end)
+    const BusRecord *peekNext() const { return atEnd() ? nullptr : &recording[next]; }
+
+    // Replays a read access and returns the recorded value
+    u16 read(BusAccess type, u32 addr, u8 fc);
+    u16 read(BusAccess type, u32 addr, u8 fc, i64 cycle);
+
+    // Replays a write access and checks it against the recording
+    bool write(BusAccess type, u32 addr, u16 value, u8 fc);
+    bool write(BusAccess type, u32 addr, u16 value, u8 fc, i64 cycle);
+
+protected:
+
+    // Advances to the next record if it matches the access
+    const BusRecord *match(BusAccess type, u32 addr, u8 fc);
+};
+
+}
+#endif
@@ -0,0 +1,186 @@
+// -----------------------------------------------------------------------------
+// This file is part of Moira - A Motorola 68k emulator
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "MoiraScheduler.h"
+#include <assert.h>
+
+namespace moira {
+
+Scheduler::Scheduler(int threads)
+{
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+
+    for (int i = 0; i < threads; i++) {
+        workers.push_back(std::unique_ptr<Worker>(new Worker()));
+    }
+    for (int i = 0; i < threads; i++) {
+        workers[i]->thread = std::thread(&Scheduler::work, this, i);
+    }
+}
+
+Scheduler::~Scheduler()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        quit = true;
+    }
+    wakeup.notify_all();
+
+    for (auto &worker : workers) worker->thread.join();
+}
+
+void
+Scheduler::configSlice(i64 cycles)
+{
+    assert(cycles > 0);
+    slice = cycles;
+}
+
+int
+Scheduler::add(Moira &cpu, i64 budget)
+{
+    instances.push_back(Instance { &cpu, budget, 0 });
+    return (int)instances.size() - 1;
+}
+
+void
+Scheduler::setBudget(int id, i64 budget)
+{
+    assert(id >= 0 && id < (int)instances.size());
+    instances[id].budget = budget;
+}
+
+void
+Scheduler::run()
+{
+    long count = 0;
+
+    // Distribute all CPUs with a positive budget among the workers
+    for (int i = 0; i < (int)instances.size(); i++) {
+
+        Instance &instance = instances[i];
+        if (instance.budget <= 0) continue;
+
+        instance.target = instance.cpu->getClock() + instance.budget;
+
+        Worker &worker = *workers[count++ % workers.size()];
+        std::lock_guard<std::mutex> guard(worker.lock);
+        worker.tasks.push_back(i);
+    }
+    if (count == 0) return;
+
+    // Wake up the pool
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        pending = count;
+        generation++;
+    }
+    wakeup.notify_all();
+
+    // Wait until all CPUs have consumed their budget
+    std::unique_lock<std::mutex> guard(lock);
+    done.wait(guard, [this] { return pending == 0; });
+}
+
+void
+Scheduler::work(int nr)
+{
+    long seen = 0;
+
+    while (true) {
+
+        // Wait for the next call to run()
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wakeup.wait(guard, [&] { return quit || generation != seen; });
+            if (quit) return;
+            seen = generation;
+        }
+
+        while (pending > 0) {
+
+            long seenQueue;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                seenQueue = requeued;
+            }
+
+            int task;
+            if (!nextTask(nr, task)) {
+
+                // Sleep until another worker requeues a CPU or all are done
+                std::unique_lock<std::mutex> guard(lock);
+                available.wait(guard, [&] { return pending == 0 || requeued != seenQueue; });
+                continue;
+            }
+
+            // Execute a single time slice
+            Instance &instance = instances[task];
+            Moira &cpu = *instance.cpu;
+            i64 end = cpu.getClock() + slice;
+            cpu.executeUntil(end < instance.target ? end : instance.target);
+
+            if (cpu.getClock() < instance.target) {
+
+                // Requeue the CPU
+                {
+                    std::lock_guard<std::mutex> guard(workers[nr]->lock);
+                    workers[nr]->tasks.push_back(task);
+                }
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    requeued++;
+                }
+                available.notify_one();
+
+            } else if (--pending == 0) {
+
+                // Signal run() and the idle workers that all CPUs are done
+                std::lock_guard<std::mutex> guard(lock);
+                done.notify_all();
+                available.notify_all();
+            }
+        }
+    }
+}
+
+bool
+Scheduler::nextTask(int nr, int &task)
+{
+    // Take the most recently queued task from the own queue
+    {
+        Worker &worker = *workers[nr];
+        std::lock_guard<std::mutex> guard(worker.lock);
+
+        if (!worker.tasks.empty()) {
+
+            task = worker.tasks.back();
+            worker.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // Steal the oldest task from another worker
+    for (size_t i = 1; i < workers.size(); i++) {
+
+        Worker &victim = *workers[(nr + i) % workers.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+
+        if (!victim.tasks.empty()) {
+
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,118 @@
+// -----------------------------------------------------------------------------
+// This file is part of Moira - A Motorola 68k emulator
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#ifndef MOIRA_SCHEDULER_H
+#define MOIRA_SCHEDULER_H
+
+#include "Moira.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace moira {
+
+/* Runs a fleet of independent CPUs on a pool of worker threads.
+ *
+ * Each CPU is executed in time slices. A time slice is a task which is put
+ * into the task queue of a worker thread. Idle workers steal tasks from the
+ * other queues. Because the slice boundaries only depend on the clock of
+ * the CPU itself, the results do not depend on the number of threads.
+ * All CPUs must be independent of each other, i.e., they must not share
+ * any state that is modified while the scheduler is running.
+ */
+class Scheduler {
+
+    struct Instance {
+
+        Moira *cpu;       // The managed CPU
+        i64 budget;       // Number of cycles to execute in each call to run()
+        i64 target;       // Clock value at which the current run ends
+    };
+
+    struct Worker {
+
+        std::thread thread;
+        std::mutex lock;
+        std::deque<int> tasks;
+    };
+
+protected:
+
+    // All managed CPUs
+    std::vector<Instance> instances;
+
+    // The worker pool
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // Maximum number of cycles a CPU executes before it is requeued
+    i64 slice = 100000;
+
+    // Synchronization between run() and the worker threads
+    std::mutex lock;
+    std::condition_variable wakeup;
+    std::condition_variable done;
+    long generation = 0;
+    bool quit = false;
+
+    // Parks idle workers until a task is requeued or all CPUs are done
+    std::condition_variable available;
+    long requeued = 0;
+
+    // Number of CPUs that haven't used up their budget yet
+    std::atomic<long> pending { 0 };
+
+
+    //
+    // Constructing and configuring
+    //
+
+public:
+
+    // Creates a worker pool (0 = one thread per hardware thread)
+    Scheduler(int threads = 0);
+    ~Scheduler();
+
+    // Sets the maximum number of cycles executed in a single time slice
+    void configSlice(i64 cycles);
+
+    // Adds a CPU with a cycle budget and returns its id
+    int add(Moira &cpu, i64 budget);
+
+    // Changes the cycle budget of a CPU
+    void setBudget(int id, i64 budget);
+
+    // Returns the number of managed CPUs or worker threads
+    long cpus() { return (long)instances.size(); }
+    long threads() { return (long)workers.size(); }
+
+
+    //
+    // Running the CPUs
+    //
+
+public:
+
+    // Runs all CPUs until each one has consumed its budget
+    void run();
+
+private:
+
+    // Main function of a worker thread
+    void work(int nr);
+
+    // Takes a task from the own queue or steals one from another worker
+    bool nextTask(int nr, int &task);
+};
+
+}
+#endif
@@ -205,6 +205,14 @@ typedef struct
 }
 InstrInfo;
 
+typedef enum
+{
+    MEM_IO,          // Accessed via the bus functions of the host
+    MEM_RAM,         // Read and written directly
+    MEM_ROM          // Read directly, writes are ignored
+}
+MemType;
+
 typedef enum
 {
     IRQ_AUTO,
@@ -223,6 +231,9 @@ typedef enum
 }
 FunctionCode;
 
+/* The field order is fixed. On little endian hosts, Moira treats the whole
+ * structure as a single 64-bit word when packing or unpacking the flags.
+ */
 struct StatusRegister {
 
     bool t;               // Trace flag
@@ -63,6 +63,8 @@ static const char *instrUpper[]
     "TAS",   "TRAP",  "TRAPV", "TST",   "UNLK"
 };
 
+#ifndef MOIRA_HANDLERS_ONLY
+
 static int decDigits(u64 value) { return value ? 1 + (int)log10(value) : 1; }
 static int binDigits(u64 value) { return value ? 1 + (int)log2(value) : 1; }
 static int hexDigits(u64 value) { return (binDigits(value) + 3) / 4; }
@@ -274,6 +276,8 @@ StrWriter::operator<<(RegRegList l)
     return *this;
 }
 
+#endif
+
 template <Instr I> StrWriter&
 StrWriter::operator<<(Ins<I> i)
 {
@@ -366,6 +370,8 @@ StrWriter::operator<<(const Ea<M,S> &ea)
     return *this;
 }
 
+#ifndef MOIRA_HANDLERS_ONLY
+
 StrWriter&
 StrWriter::operator<<(Finish)
 {
@@ -374,6 +380,8 @@ StrWriter::operator<<(Finish)
     return *this;
 }
 
+#endif
+
 template <Mode M, Size S> void
 StrWriter::briefExtension(const Ea<M,S> &ea)
 {
@@ -19,17 +19,15 @@ Sandbox::Sandbox()
 void
 Sandbox::prepare()
 {
-    recordCnt = replayCnt = 0;
+    recorder.clear();
+    replayer.rewind();
     errors = 0;
 }
 
 void
 Sandbox::record(AccessType type, u32 addr, u64 cycle, u32 fc, u16 value)
 {
-    access[recordCnt] = AccessRecord { type, addr, value, cycle, fc };
-
-    recordCnt++;
-    assert(recordCnt < 64);
+    recorder.record((moira::BusAccess)type, addr, value, (moira::i64)cycle, (u8)fc);
 }
 
 void
@@ -41,79 +39,41 @@ Sandbox::recordPoll(u64 cycle, u32 fc, u8 value)
 u32
 Sandbox::replayPeek(AccessType type, u32 addr, u64 cycle, u32 fc)
 {
-    for (int i = 0; i < recordCnt; i++) {
-
-        // Enable for strict checking
-        if (i != replayCnt) continue;
+    // Check the access with the next sequence number (strict checking)
+    long mismatches = replayer.getMismatches();
+    u16 value = replayer.read((moira::BusAccess)type, addr, (u8)fc);
 
-        // Check for a matching entry
-        if (access[i].type != type) continue;
-        if (access[i].addr != addr) continue;
-        if (access[i].fc != fc) continue;
-        // if (access[i].cycle != cycle) continue;
-
-        replayCnt++;
-        if (replayCnt > recordCnt) { break; }
-        return access[i].value;
-    }
-
-    error(type, addr, cycle, fc);
-    return 0;
+    if (replayer.getMismatches() != mismatches) error(type, addr, cycle, fc);
+    return value;
 }
 
 u8
 Sandbox::replayPoll(u64 cycle, u32 fc)
 {
-    for (int i = 0; i < recordCnt; i++) {
-
-        // Enable for strict checking
-        if (i != replayCnt) continue;
-
-        // Check for a matching entry
-        if (access[i].type != POLL) continue;
-        if (access[i].cycle != cycle) continue;
-        if (access[i].fc != fc) continue;
+    // Check the access with the next sequence number (strict checking)
+    long mismatches = replayer.getMismatches();
+    u16 value = replayer.read(moira::BUS_POLL, 0, (u8)fc, (moira::i64)cycle);
 
-        replayCnt++;
-        if (replayCnt > recordCnt) { break; }
-        return (u8)access[i].value;
-    }
-
-    error(POLL, 0, cycle, fc);
-    return 0;
+    if (replayer.getMismatches() != mismatches) error(POLL, 0, cycle, fc);
+    return (u8)value;
 }
 
 void
 Sandbox::replayPoke(AccessType type, u32 addr, u64 cycle, u32 fc, u16 value)
 {
-    for (int i = 0; i < recordCnt; i++) {
-
-        // Enable for strict checking
-        if (i != replayCnt) continue;
-
-        // Check for a matching entry
-        if (access[i].type != type) continue;
-        if (access[i].addr != addr) continue;
-        if (access[i].value != value) continue;
-        if (access[i].fc != fc) continue;
-        if (!MIMIC_MUSASHI) {
-            if (access[i].cycle != cycle) continue;
-        }
-
-        // Match found
-        replayCnt++;
-        if (replayCnt > recordCnt) { break; }
-        return;
-    }
+    // Check the access with the next sequence number (strict checking)
+    bool match = MIMIC_MUSASHI ?
+    replayer.write((moira::BusAccess)type, addr, value, (u8)fc) :
+    replayer.write((moira::BusAccess)type, addr, value, (u8)fc, (moira::i64)cycle);
 
-    error(type, addr, cycle, fc, value);
+    if (!match) error(type, addr, cycle, fc, value);
 }
 
 void
 Sandbox::error(AccessType type, u32 addr, u64 cycle, u32 fc, u16 value)
 {
-    printf("\nACCESS %d DOESN'T MATCH:\n", replayCnt);
-    printf("i: %2d  ", replayCnt);
+    printf("\nACCESS %ld DOESN'T MATCH:\n", replayer.position());
+    printf("i: %2ld  ", replayer.position());
     printf("Type: %s  ", accessTypeStr[type]);
     printf("Addr: %4x  ", addr);
     printf("Cycle: %lud  ", (long)cycle);
@@ -121,13 +81,13 @@ Sandbox::error(AccessType type, u32 addr, u64 cycle, u32 fc, u16 value)
     if (type == POKE8 || type == POKE16) printf("Value: %4x  ", value);
     printf("\n\n");
     printf("ACCESS RECORD:\n");
-    for (int i = 0; i < recordCnt; i++) {
-        printf("i: %2d  ", i);
-        printf("Type: %s  ", accessTypeStr[access[i].type]);
-        printf("Addr: %4x  ", access[i].addr);
-        printf("Cycle: %3lud  ", (long)access[i].cycle);
-        printf("FC: %d  ", access[i].fc);
-        printf("Value: %4x  ", access[i].value);
+    for (long i = 0; i < recorder.size(); i++) {
+        printf("i: %2ld  ", i);
+        printf("Type: %s  ", accessTypeStr[recorder[i].type]);
+        printf("Addr: %4x  ", recorder[i].addr);
+        printf("Cycle: %3lud  ", (long)recorder[i].cycle);
+        printf("FC: %d  ", recorder[i].fc);
+        printf("Value: %4x  ", recorder[i].value);
         printf("\n");
     }
     errors++;
@@ -11,12 +11,14 @@
 #define SANDBOX_H
 
 #include "MoiraTypes.h"
+#include "MoiraRecorder.h"
 
 using moira::u8;
 using moira::u16;
 using moira::u32;
 using moira::u64;
 
+// Access types (same encoding as moira::BusAccess)
 enum AccessType {
     PEEK8,
     PEEK16,
@@ -31,20 +33,10 @@ static const char *accessTypeStr[] = {
     "Poll  "
 };
 
-struct AccessRecord {
-
-    AccessType type;
-    u32 addr;
-    u16 value;
-    u64 cycle;
-    u32 fc;
-};
-
 class Sandbox {
 
-    AccessRecord access[64];
-    int recordCnt;
-    int replayCnt;
+    moira::BusRecorder recorder;
+    moira::BusReplayer replayer { recorder };
     long errors;
 
 public:
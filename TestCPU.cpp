@@ -117,3 +117,66 @@ TestCPU::breakpointReached(moira::u32 addr) { }
  */
 void
 TestCPU::watchpointReached(moira::u32 addr) { }
+
+u8
+FleetCPU::read8(u32 addr)
+{
+    if (coordinator && coordinator->isShared(addr)) return coordinator->read8(id, addr);
+
+    u8 result = get8(mem, addr);
+    if (recorder) recorder->record(BUS_PEEK8, addr, result, getClock(), (u8)readFC());
+    return result;
+}
+
+u16
+FleetCPU::read16(u32 addr)
+{
+    if (coordinator && coordinator->isShared(addr)) return coordinator->read16(id, addr);
+
+    u16 result = get16(mem, addr);
+    if (recorder) recorder->record(BUS_PEEK16, addr, result, getClock(), (u8)readFC());
+    return result;
+}
+
+u16
+FleetCPU::read16OnReset(u32 addr)
+{
+    switch (addr) {
+        case 0: return 0x0000;
+        case 2: return 0x8000;
+        case 4: return 0x0000;
+        case 6: return 0x1000;
+    }
+    return get16(mem, addr);
+}
+
+void
+FleetCPU::write8(u32 addr, u8  val)
+{
+    if (coordinator && coordinator->isShared(addr)) { coordinator->write8(id, addr, val); return; }
+
+    if (recorder) recorder->record(BUS_POKE8, addr, val, getClock(), (u8)readFC());
+    set8(mem, addr, val);
+}
+
+void
+FleetCPU::write16(u32 addr, u16 val)
+{
+    if (coordinator && coordinator->isShared(addr)) { coordinator->write16(id, addr, val); return; }
+
+    if (recorder) recorder->record(BUS_POKE16, addr, val, getClock(), (u8)readFC());
+    set16(mem, addr, val);
+}
+
+void
+FleetCPU::irqOccurred(u8 level)
+{
+    setIPL(0);
+}
+
+void
+FleetCPU::eventTriggered(i64 nr)
+{
+    callbacks.push_back(std::make_pair(nr, getClock()));
+    mem[0x5000] = (u8)(nr | 1);
+}
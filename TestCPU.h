@@ -11,6 +11,9 @@
 #define TESTCPU_H
 
 #include "Moira.h"
+#include "MoiraCoordinator.h"
+#include "MoiraRecorder.h"
+#include <vector>
 
 using namespace moira;
 
@@ -28,4 +31,42 @@ class TestCPU : public Moira {
     void watchpointReached(u32 addr) override;
 };
 
+/* A CPU with private memory
+ *
+ * Used to check that the results of the scheduler and the coordinator don't
+ * depend on the number of worker threads. If a coordinator is connected,
+ * accesses to the shared memory area are routed through it. The CPU is also
+ * used to compare the results of a guest program with optional features
+ * enabled and disabled. If a recorder is connected, all accesses to private
+ * memory are recorded. Each callback writes its id into memory cell $5000
+ * and is logged together with the cycle it was served at. Each interrupt
+ * clears the IPL lines.
+ */
+class FleetCPU : public Moira {
+
+public:
+
+    u8 mem[0x10000];
+
+    Coordinator *coordinator = nullptr;
+    int id = 0;
+
+    // Ids of the served callbacks and the cycles they were served at
+    std::vector<std::pair<i64, i64>> callbacks;
+
+    // If set, all accesses to private memory are recorded
+    BusRecorder *recorder = nullptr;
+
+private:
+
+    void irqOccurred(u8 level) override;
+    void eventTriggered(i64 nr) override;
+
+    u8 read8(u32 addr) override;
+    u16 read16(u32 addr) override;
+    u16 read16OnReset(u32 addr) override;
+    void write8 (u32 addr, u8  val) override;
+    void write16 (u32 addr, u16 val) override;
+};
+
 #endif
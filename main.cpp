@@ -1,19 +1,27 @@
-// -----------------------------------------------------------------------------
-// This file is part of Moira - A Motorola 68k emulator
-//
-// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
-// Licensed under the GNU General Public License v3
-//
-// See https://www.gnu.org for license information
-// -----------------------------------------------------------------------------
-
-#include "testrunner.h"
-
-int main()
-{
-    moiracpu = new TestCPU();
-    run();
-
-    return 0;
-}
-
+// -----------------------------------------------------------------------------
+// This file is part of Moira - A Motorola 68k emulator
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "testrunner.h"
+
+int main(int argc, char **argv)
+{
+    moiracpu = new TestCPU();
+
+    // Run the benchmarks instead of the tests if requested
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+
+        benchmarkMul();
+        return 0;
+    }
+
+    run();
+
+    return 0;
+}
+
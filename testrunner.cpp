@@ -122,6 +122,20 @@ void run()
     setupMoira();
     srand(0); // (int)time(NULL));
 
+    testBcd();
+    testShift();
+    testMul();
+    testDiv();
+    testScheduler();
+    testCoordinator();
+    testEvents();
+    testFastForward();
+    testRegions();
+    testBlocks();
+    testVectors();
+    testBus();
+    testRecorder();
+
     for (long round = 1 ;; round++) {
 
         printf("Round %ld ", round); fflush(stdout);
@@ -148,6 +162,980 @@ void run()
     }
 }
 
+u16 referenceBcd(bool sub, u8 op1, u8 op2, bool x)
+{
+    u16 op1_hi = op1 & 0xF0, op1_lo = op1 & 0x0F;
+    u16 op2_hi = op2 & 0xF0, op2_lo = op2 & 0x0F;
+    u16 result, tmp_result, resLo, resHi;
+    bool c, v;
+
+    if (!sub) {
+
+        resLo = op1_lo + op2_lo + x;
+        resHi = op1_hi + op2_hi;
+        result = tmp_result = resHi + resLo;
+        if (resLo > 9) result += 6;
+        c = (result & 0x3F0) > 0x90;
+        if (c) result += 0x60;
+        v = ((tmp_result & 0x80) == 0) && ((result & 0x80) == 0x80);
+
+    } else {
+
+        resLo = op2_lo - op1_lo - x;
+        resHi = op2_hi - op1_hi;
+        result = tmp_result = resHi + resLo;
+        int bcd = 0;
+        if (resLo & 0xf0) { bcd = 6; result -= 6; }
+        if (((op2 - op1 - x) & 0x100) > 0xff) result -= 0x60;
+        c = ((op2 - op1 - bcd - x) & 0x300) > 0xff;
+        v = ((tmp_result & 0x80) == 0x80) && ((result & 0x80) == 0);
+    }
+
+    // Z is only cleared (it is set in advance by the caller)
+    u8 ccr = (c ? 0x11 : 0) | (v ? 0x02 : 0) | (result & 0x80 ? 0x08 : 0);
+    if (!(result & 0xFF)) ccr |= 0x04;
+
+    return (u16)(ccr << 8 | (result & 0xFF));
+}
+
+void testBcd()
+{
+    printf("Verifying BCD arithmetic ");
+
+    // ABCD D0,D1 / SBCD D0,D1 / NBCD D1
+    const u16 opcodes[3] = { 0xC300, 0x8300, 0x4801 };
+
+    for (int i = 0; i < 3; i++) {
+
+        printf("."); fflush(stdout);
+        set16(moiraMem, pc, opcodes[i]);
+
+        for (int op = 0; op < 0x20000; op++) {
+
+            u8 op1 = (op >> 8) & 0xFF, op2 = op & 0xFF;
+            bool x = op >> 16;
+
+            // NBCD only depends on a single operand
+            if (i == 2 && op2) continue;
+
+            moiracpu->reset();
+            moiracpu->setD(0, op1);
+            moiracpu->setD(1, i == 2 ? op1 : op2);
+            moiracpu->setCCR(x ? 0x14 : 0x04);
+            moiracpu->execute();
+
+            u16 expected = i == 2 ?
+            referenceBcd(true, op1, 0, x) : referenceBcd(i == 1, op1, op2, x);
+            u16 result = (u16)(moiracpu->getCCR() << 8 | (moiracpu->getD(1) & 0xFF));
+
+            if (result != expected) {
+
+                printf("\nBCD MISMATCH FOUND (opcode %04x, op1 = %02x, op2 = %02x, X = %d)",
+                       opcodes[i], op1, op2, x);
+                printf(": Result: %04x Expected: %04x\n\n", result, expected);
+                bugReport();
+            }
+        }
+    }
+    printf(" PASSED\n\n");
+}
+
+u64 referenceShift(int type, bool left, int size, int cnt, u32 data, bool x)
+{
+    const u64 msb = 1ULL << (8 * size - 1), mask = (msb << 1) - 1;
+    u64 d = data & mask, changed = 0;
+    bool carry = type == 2 ? x : false;
+
+    for (int i = 0; i < cnt; i++) {
+
+        bool extend = carry;
+
+        if (left) {
+
+            carry = d & msb;
+            u64 shifted = d << 1;
+            if (type == 2 && extend) shifted |= 1;
+            if (type == 3 && carry) shifted |= 1;
+            changed |= d ^ shifted;
+            d = shifted & mask;
+
+        } else {
+
+            carry = d & 1;
+            u64 shifted = d >> 1;
+            if (type == 0 && (d & msb)) shifted |= msb;
+            if (type == 2 && extend) shifted |= msb;
+            if (type == 3 && carry) shifted |= msb;
+            d = shifted;
+        }
+    }
+
+    // X is unaffected by rotations and by shifts with a zero count
+    if (type == 2 || (type != 3 && cnt)) x = carry;
+    bool v = type == 0 && left && (changed & msb);
+
+    u8 ccr = (x ? 0x10 : 0) | (d & msb ? 0x08 : 0) | (d ? 0 : 0x04) |
+    (v ? 0x02 : 0) | (carry ? 0x01 : 0);
+
+    return (u64)ccr << 32 | d;
+}
+
+void testShift()
+{
+    printf("Verifying shift and rotate instructions ");
+
+    const int sizes[3] = { 1, 2, 4 };
+
+    for (int type = 0; type < 4; type++) {
+
+        printf("."); fflush(stdout);
+
+        for (int left = 0; left < 2; left++) {
+
+            for (int s = 0; s < 3; s++) {
+
+                // <type>.<size> D0,D1
+                u16 opcode = (u16)(0xE021 | left << 8 | s << 6 | type << 3);
+                set16(moiraMem, pc, opcode);
+
+                for (int i = 0; i < 512; i++) {
+
+                    // All byte values or smart random values
+                    u32 data = s == 0 ? (u32)(i & 0xFF) : smartRandom();
+
+                    for (int cnt = 0; cnt < 64; cnt++) {
+
+                        for (int x = 0; x < 2; x++) {
+
+                            moiracpu->reset();
+                            moiracpu->setD(0, (u32)cnt);
+                            moiracpu->setD(1, data);
+                            moiracpu->setCCR(x ? 0x1F : 0x0F);
+                            moiracpu->execute();
+
+                            u64 expected = referenceShift(type, left, sizes[s], cnt, data, x);
+                            u64 mask = (2ULL << (8 * sizes[s] - 1)) - 1;
+                            u64 result = (u64)moiracpu->getCCR() << 32 | (moiracpu->getD(1) & mask);
+
+                            if (result != expected) {
+
+                                printf("\nSHIFT MISMATCH FOUND (opcode %04x, data = %08x, count = %d, X = %d)",
+                                       opcode, data, cnt, x);
+                                printf(": Result: %010llx Expected: %010llx\n\n",
+                                       (unsigned long long)result, (unsigned long long)expected);
+                                bugReport();
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    printf(" PASSED\n\n");
+}
+
+int referenceMulCycles(bool sign, u16 data)
+{
+    int mcycles = 17;
+
+    if (sign) data = ((data << 1) ^ data) & 0xFFFF;
+    for (; data; data >>= 1) if (data & 1) mcycles++;
+
+    return 2 * mcycles;
+}
+
+void testMul()
+{
+    printf("Verifying MUL timing ");
+
+    const Instr instr[2] = { MULU, MULS };
+
+    for (int i = 0; i < 2; i++) {
+
+        printf("."); fflush(stdout);
+
+        for (int op = 0; op < 0x10000; op++) {
+
+            int cycles = moiracpu->getMulCycles(instr[i], (u16)op);
+            int expected = referenceMulCycles(i == 1, (u16)op);
+
+            if (cycles != expected) {
+
+                printf("\nMUL TIMING MISMATCH FOUND (%s, op = %04x)", i ? "MULS" : "MULU", op);
+                printf(": Cycles: %d Expected: %d\n\n", cycles, expected);
+                bugReport();
+            }
+        }
+    }
+    printf(" PASSED\n\n");
+}
+
+int referenceDivCycles(bool sign, u32 op1, u16 op2)
+{
+    if (!sign) {
+
+        u32 dividend = op1;
+        u16 divisor  = op2;
+        int mcycles  = 38;
+
+        if ((dividend >> 16) >= divisor) return 10;
+        u32 hdivisor = divisor << 16;
+
+        for (int i = 0; i < 15; i++) {
+            if ((i32)dividend < 0) {
+                dividend <<= 1;
+                dividend -= hdivisor;
+            } else {
+                dividend <<= 1;
+                if (dividend >= hdivisor) {
+                    dividend -= hdivisor;
+                    mcycles += 1;
+                } else {
+                    mcycles += 2;
+                }
+            }
+        }
+        return 2 * mcycles;
+
+    } else {
+
+        i32 dividend = (i32)op1;
+        i16 divisor  = (i16)op2;
+        int mcycles  = (dividend < 0) ? 7 : 6;
+
+        if ((abs(dividend) >> 16) >= abs(divisor))
+            return (mcycles + 2) * 2;
+
+        mcycles += 55;
+
+        if (divisor >= 0) {
+            mcycles += (dividend < 0) ? 1 : -1;
+        }
+
+        u32 aquot = abs(dividend) / abs(divisor);
+        for (int i = 0; i < 15; i++) {
+            if ( (i16)aquot >= 0) mcycles++;
+            aquot <<= 1;
+        }
+        return 2 * mcycles;
+    }
+}
+
+void testDiv()
+{
+    printf("Verifying DIV timing ");
+
+    for (u32 d = 1; d <= 0xFFFF; d++) {
+
+        if ((d & 0x3FFF) == 0) { printf("."); fflush(stdout); }
+
+        // Sparse, dense, and random quotients
+        u32 quotients[7] = { 0, 1, 0x5555, 0xAAAA, 0x8001, 0xFFFF, (u32)rand() & 0xFFFF };
+
+        for (int i = 0; i < 8; i++) {
+
+            // Minimal and maximal remainders, and a random (overflowing) dividend
+            u32 q = i < 7 ? quotients[i] : 0;
+            u32 dividends[2] = { q * d, q * d + d - 1 };
+            if (i == 7) dividends[0] = dividends[1] = (u32)rand() << 16 ^ (u32)rand();
+
+            for (int j = 0; j < 2; j++) {
+
+                int cycles = moiracpu->getDivCycles(DIVU, dividends[j], (u16)d);
+                int expected = referenceDivCycles(false, dividends[j], (u16)d);
+
+                if (cycles != expected) {
+
+                    printf("\nDIV TIMING MISMATCH FOUND (DIVU, %08x / %04x)", dividends[j], d);
+                    printf(": Cycles: %d Expected: %d\n\n", cycles, expected);
+                    bugReport();
+                }
+            }
+
+            // Signed variants (the magnitude of the quotient is limited to 15 bit)
+            i32 ad = abs((i16)d), aq = (i32)(q & 0x7FFF);
+            i32 mags[2] = { aq * ad, aq * ad + ad - 1 };
+            if (i == 7) mags[0] = mags[1] = (i32)(dividends[0] & 0x7FFFFFFF);
+
+            for (int j = 0; j < 4; j++) {
+
+                u32 dividend = (u32)(j & 2 ? -mags[j & 1] : mags[j & 1]);
+
+                int cycles = moiracpu->getDivCycles(DIVS, dividend, (u16)d);
+                int expected = referenceDivCycles(true, dividend, (u16)d);
+
+                if (cycles != expected) {
+
+                    printf("\nDIV TIMING MISMATCH FOUND (DIVS, %08x / %04x)", dividend, d);
+                    printf(": Cycles: %d Expected: %d\n\n", cycles, expected);
+                    bugReport();
+                }
+            }
+        }
+    }
+    printf(" PASSED\n\n");
+}
+
+static void hash(u64 &h, u64 value)
+{
+    h = (h ^ value) * 1099511628211ULL;
+}
+
+u64 runFleet(int threads)
+{
+    std::vector<std::unique_ptr<FleetCPU>> cpus;
+    Scheduler scheduler(threads);
+    scheduler.configSlice(7777);
+
+    for (int i = 0; i < 48; i++) {
+
+        cpus.push_back(std::unique_ptr<FleetCPU>(new FleetCPU()));
+        u8 *mem = cpus.back()->mem;
+        memset(mem, 0, 0x10000);
+
+        // MOVE.L #seed,D0; LEA $4000.W,A0
+        // loop: MULU #$4E6D,D0; ADDQ.L #1,D0; MOVE.W D0,(A0)+; BRA.S loop
+        const u16 prog[] = {
+            0x203C, 0x0000, (u16)(i * 97 + 1), 0x41F8, 0x4000,
+            0xC0FC, 0x4E6D, 0x5280, 0x30C0, 0x60F6 };
+
+        for (int k = 0; k < 10; k++) set16(mem, pc + 2 * k, prog[k]);
+
+        cpus.back()->reset();
+        scheduler.add(*cpus.back(), 100000 + 5000 * (i % 13));
+    }
+
+    for (int round = 0; round < 5; round++) {
+
+        if (round == 2) scheduler.setBudget(3, 0);
+        scheduler.run();
+    }
+
+    u64 h = 1469598103934665603ULL;
+    for (auto &cpu : cpus) {
+
+        for (int i = 0; i < 0x10000; i++) hash(h, cpu->mem[i]);
+        hash(h, (u64)cpu->getClock());
+        hash(h, cpu->getD(0));
+    }
+    return h;
+}
+
+void testScheduler()
+{
+    printf("Verifying the scheduler ");
+
+    u64 expected = runFleet(1);
+
+    for (int threads : { 2, 3, 8 }) {
+
+        printf("."); fflush(stdout);
+        u64 result = runFleet(threads);
+
+        if (result != expected) {
+
+            printf("\nSCHEDULER MISMATCH FOUND (%d threads)", threads);
+            printf(": Hash: %016llx Expected: %016llx\n\n",
+                   (unsigned long long)result, (unsigned long long)expected);
+            bugReport();
+        }
+    }
+    printf(" PASSED\n\n");
+}
+
+u64 runSharedFleet(int threads)
+{
+    static u8 shared[0x1000];
+    std::vector<std::unique_ptr<FleetCPU>> cpus;
+    Coordinator coordinator;
+
+    memset(shared, 0, sizeof(shared));
+    coordinator.mapShared(0x8000, sizeof(shared), shared);
+    coordinator.configQuantum(500);
+
+    for (int i = 0; i < 4; i++) {
+
+        cpus.push_back(std::unique_ptr<FleetCPU>(new FleetCPU()));
+        FleetCPU &cpu = *cpus.back();
+        memset(cpu.mem, 0, 0x10000);
+
+        // MOVE.W #i+1,D0; LEA $8100,A0
+        // loop: ADDQ.W #1,$8000; MOVE.W $8000,D1; MOVE.W D1,(A0)+
+        //       ADD.W $8002,D1; MOVE.W D1,$8002; CMPA.L #$8F00,A0
+        //       BNE.S skip; LEA $8100,A0; skip: BRA.S loop
+        const u16 prog[] = {
+            0x303C, (u16)(i + 1), 0x41F9, 0x0000, 0x8100,
+            0x5279, 0x0000, 0x8000, 0x3239, 0x0000, 0x8000, 0x30C1,
+            0xD279, 0x0000, 0x8002, 0x33C1, 0x0000, 0x8002,
+            0xB1FC, 0x0000, 0x8F00, 0x6606, 0x41F9, 0x0000, 0x8100, 0x60D6 };
+
+        for (int k = 0; k < 26; k++) set16(cpu.mem, pc + 2 * k, prog[k]);
+
+        cpu.coordinator = &coordinator;
+        cpu.id = coordinator.add(cpu);
+        cpu.reset();
+    }
+
+    coordinator.configParallel(threads);
+    coordinator.runUntil(200000);
+    coordinator.runUntil(400000);
+
+    u64 h = 1469598103934665603ULL;
+    for (int i = 0; i < (int)sizeof(shared); i++) hash(h, shared[i]);
+    for (auto &cpu : cpus) {
+
+        hash(h, (u64)cpu->getClock());
+        hash(h, cpu->getD(1));
+    }
+    return h;
+}
+
+void testCoordinator()
+{
+    printf("Verifying the coordinator ");
+
+    u64 expected = runSharedFleet(1);
+
+    for (int threads : { 2, 4, 8 }) {
+
+        printf("."); fflush(stdout);
+        u64 result = runSharedFleet(threads);
+
+        if (result != expected) {
+
+            printf("\nCOORDINATOR MISMATCH FOUND (%d threads)", threads);
+            printf(": Hash: %016llx Expected: %016llx\n\n",
+                   (unsigned long long)result, (unsigned long long)expected);
+            bugReport();
+        }
+    }
+    printf(" PASSED\n\n");
+}
+
+// MOVE.W #$2000,SR
+// poll: TST.B $5000.W; BEQ.S poll; CLR.B $5000.W; ADDQ.W #1,D2
+//       MOVE.W #500,D0; DBRA D0,*; ADDQ.W #1,D3
+//       STOP #$2000; ADDQ.W #1,D4; BRA.S poll
+const u16 idleGuest[17] = {
+    0x46FC, 0x2000, 0x4A38, 0x5000, 0x67FA, 0x4238, 0x5000, 0x5242,
+    0x303C, 0x01F4, 0x51C8, 0xFFFE, 0x5243, 0x4E72, 0x2000, 0x5244,
+    0x60E2 };
+
+void loadGuest(FleetCPU &cpu, const u16 *prog, int words)
+{
+    memset(cpu.mem, 0, sizeof(cpu.mem));
+    for (int k = 0; k < words; k++) set16(cpu.mem, pc + 2 * k, prog[k]);
+
+    for (int v = 2; v < 256; v++) set16(cpu.mem, 4 * v + 2, 0x1200);
+    set16(cpu.mem, 0x1200, 0x5247);
+    set16(cpu.mem, 0x1202, 0x4E73);
+
+    cpu.callbacks.clear();
+    cpu.reset();
+}
+
+i64 guestCallback(int nr)
+{
+    return 500 + (nr / 2) * 7919 % (GUEST_CYCLES - 10000);
+}
+
+void runGuest(FleetCPU &cpu, i64 chunk)
+{
+    i64 start = cpu.getClock(), end = start + GUEST_CYCLES;
+
+    for (int i = 0; i < 48; i++) {
+        cpu.events.scheduleCallback(start + guestCallback(i), i);
+    }
+    for (int i = 0; i < 24; i++) {
+        cpu.events.scheduleIPL(start + 1000 + i * 6133 % (GUEST_CYCLES - 10000), 3);
+    }
+    for (i64 cycle = start; cycle < end; cycle += chunk) {
+        cpu.executeUntil(std::min(cycle + chunk, end));
+    }
+}
+
+u64 hashGuest(FleetCPU &cpu)
+{
+    u64 h = 1469598103934665603ULL;
+
+    for (int i = 0; i < 0x10000; i++) hash(h, cpu.mem[i]);
+    for (int i = 0; i < 8; i++) hash(h, cpu.getD(i));
+    for (int i = 0; i < 8; i++) hash(h, cpu.getA(i));
+    for (auto &cb : cpu.callbacks) { hash(h, (u64)cb.first); hash(h, (u64)cb.second); }
+    hash(h, cpu.getPC());
+    hash(h, cpu.getSR());
+    hash(h, (u64)cpu.getClock());
+    return h;
+}
+
+void testEvents()
+{
+    printf("Verifying the event queue ");
+
+    std::unique_ptr<FleetCPU> cpu(new FleetCPU());
+    loadGuest(*cpu, idleGuest, 17);
+    i64 start = cpu->getClock();
+    runGuest(*cpu, GUEST_CYCLES);
+    u64 expected = hashGuest(*cpu);
+
+    // Callbacks must be served in trigger order (FIFO order if they tie)
+    printf("."); fflush(stdout);
+    bool valid = cpu->callbacks.size() == 48;
+    for (size_t i = 0; valid && i < cpu->callbacks.size(); i++) {
+
+        i64 nr = cpu->callbacks[i].first, cycle = start + guestCallback((int)nr);
+        valid &= cpu->callbacks[i].second >= cycle && cpu->callbacks[i].second < cycle + 200;
+
+        if (i > 0) {
+
+            i64 prev = cpu->callbacks[i - 1].first;
+            i64 pcycle = start + guestCallback((int)prev);
+            valid &= pcycle < cycle || (pcycle == cycle && prev < nr);
+        }
+    }
+    if (!valid) {
+
+        printf("\nEVENT QUEUE MISMATCH FOUND (%d callbacks served, order or cycle invalid)\n\n",
+               (int)cpu->callbacks.size());
+        bugReport();
+    }
+
+    // The result must not depend on how executeUntil() slices the run
+    for (i64 chunk : { 1000, 97, 1 }) {
+
+        printf("."); fflush(stdout);
+        loadGuest(*cpu, idleGuest, 17);
+        runGuest(*cpu, chunk);
+        u64 result = hashGuest(*cpu);
+
+        if (result != expected) {
+
+            printf("\nEVENT QUEUE MISMATCH FOUND (slices of %lld cycles)", (long long)chunk);
+            printf(": Hash: %016llx Expected: %016llx\n\n",
+                   (unsigned long long)result, (unsigned long long)expected);
+            bugReport();
+        }
+    }
+    printf(" PASSED\n\n");
+}
+
+u64 runFastForward(int features, i64 chunk)
+{
+    std::unique_ptr<FleetCPU> cpu(new FleetCPU());
+
+    cpu->configStopSkipping(features & 1);
+    cpu->configIdleDetection(features & 2);
+    cpu->configDelayLoopSkipping(features & 4);
+    loadGuest(*cpu, idleGuest, 17);
+    runGuest(*cpu, chunk);
+    return hashGuest(*cpu);
+}
+
+void testFastForward()
+{
+    printf("Verifying the fast-forward features ");
+
+    u64 expected = runFastForward(0, GUEST_CYCLES);
+
+    for (int features = 1; features < 8; features++) {
+
+        printf("."); fflush(stdout);
+
+        for (i64 chunk : { (i64)GUEST_CYCLES, (i64)1000, (i64)97 }) {
+
+            u64 result = runFastForward(features, chunk);
+
+            if (result != expected) {
+
+                printf("\nFAST-FORWARD MISMATCH FOUND (features %d, slices of %lld cycles)",
+                       features, (long long)chunk);
+                printf(": Hash: %016llx Expected: %016llx\n\n",
+                       (unsigned long long)result, (unsigned long long)expected);
+                bugReport();
+            }
+        }
+    }
+    printf(" PASSED\n\n");
+}
+
+u64 runRegions(bool direct)
+{
+    std::unique_ptr<FleetCPU> cpu(new FleetCPU());
+    u8 *mem = cpu->mem;
+
+    for (int i = 0; i < 0x10000; i++) mem[i] = (u8)(i * 7 + 3);
+    if (direct) {
+
+        cpu->mapMemory(0x000000, 0x10000, MEM_RAM, mem);
+        cpu->mapMemory(0xFF0000, 0x10000, MEM_RAM, mem);
+    }
+
+    // MOVE.W $3001.W,D0; MOVE.W #$ABCD,$3011.W; MOVE.W $3011.W,D1
+    // MOVE.B $3012.W,D2; MOVE.L $3005.W,D3; MOVE.L #$12345678,$3021.W
+    // MOVE.W $FFFF.W,D4; MOVE.W #$1234,$FFFF.W; MOVE.W $0000.W,D5
+    const u16 prog[] = {
+        0x3038, 0x3001, 0x31FC, 0xABCD, 0x3011, 0x3238, 0x3011,
+        0x1438, 0x3012, 0x2638, 0x3005, 0x21FC, 0x1234, 0x5678, 0x3021,
+        0x3838, 0xFFFF, 0x31FC, 0x1234, 0xFFFF, 0x3A38, 0x0000 };
+
+    for (int k = 0; k < 22; k++) set16(mem, pc + 2 * k, prog[k]);
+
+    cpu->reset();
+    for (int i = 0; i < 9; i++) cpu->execute();
+
+    u64 h = 1469598103934665603ULL;
+    for (int i = 0; i < 0x10000; i++) hash(h, mem[i]);
+    for (int i = 0; i < 8; i++) hash(h, cpu->getD(i));
+    hash(h, cpu->getPC());
+    hash(h, (u64)cpu->getClock());
+    return h;
+}
+
+void testRegions()
+{
+    printf("Verifying the memory map ");
+
+    u64 expected = runRegions(false);
+    printf("."); fflush(stdout);
+    u64 result = runRegions(true);
+
+    if (result != expected) {
+
+        printf("\nMEMORY MAP MISMATCH FOUND (RAM region)");
+        printf(": Hash: %016llx Expected: %016llx\n\n",
+               (unsigned long long)result, (unsigned long long)expected);
+        bugReport();
+    }
+    printf(" PASSED\n\n");
+}
+
+// MOVE.W #$2000,SR
+// loop: LEA $4000.W,A0; LEA $4060.W,A1; MOVEM.L (A0)+,D0-D7/A2-A6
+//       ADDQ.L #1,D0; MOVEM.L D0-D7/A2-A6,-(A1); MOVEM.W (A0),D1/D3/A4
+//       MOVEM.W D0-D3/A5,-(A1); MOVEM.L D0/D2/A3,$10(A1)
+//       MOVEM.W $20(A0),D4-D6; MOVEM.L $4100.W,D0-D1
+//       MOVEM.L D6-D7,$4108.W; ADDQ.L #1,D1; BRA.S loop
+const u16 movemGuest[29] = {
+    0x46FC, 0x2000, 0x41F8, 0x4000, 0x43F8, 0x4060, 0x4CD8, 0x7CFF,
+    0x5280, 0x48E1, 0xFF3E, 0x4C90, 0x100A, 0x48A1, 0xF004, 0x48E9,
+    0x0805, 0x0010, 0x4CA8, 0x0070, 0x0020, 0x4CF8, 0x0003, 0x4100,
+    0x48F8, 0x00C0, 0x4108, 0x5281, 0x60CA };
+
+// MOVE.W #$2000,SR
+// loop: TRAP #0; TRAP #1; MOVE.W #2,CCR; TRAPV; DIVU.W #0,D1
+//       ADDQ.L #1,D0; BRA.S loop
+const u16 frameGuest[11] = {
+    0x46FC, 0x2000, 0x4E40, 0x4E41, 0x44FC, 0x0002, 0x4E76, 0x82FC,
+    0x0000, 0x5280, 0x60EE };
+
+u64 runMapped(const u16 *prog, int words, bool direct)
+{
+    std::unique_ptr<FleetCPU> cpu(new FleetCPU());
+
+    if (direct) cpu->mapMemory(0x000000, 0x10000, MEM_RAM, cpu->mem);
+    loadGuest(*cpu, prog, words);
+    for (int i = 0x4000; i < 0x4200; i++) cpu->mem[i] = (u8)(i * 13 + 5);
+
+    runGuest(*cpu, GUEST_CYCLES);
+    return hashGuest(*cpu);
+}
+
+void testBlocks()
+{
+    printf("Verifying block transfers ");
+
+    const u16 *guests[2] = { movemGuest, frameGuest };
+    const int words[2] = { 29, 11 };
+    const char *names[2] = { "MOVEM", "stack frames" };
+
+    for (int i = 0; i < 2; i++) {
+
+        printf("."); fflush(stdout);
+        u64 expected = runMapped(guests[i], words[i], false);
+        u64 result = runMapped(guests[i], words[i], true);
+
+        if (result != expected) {
+
+            printf("\nBLOCK TRANSFER MISMATCH FOUND (%s)", names[i]);
+            printf(": Hash: %016llx Expected: %016llx\n\n",
+                   (unsigned long long)result, (unsigned long long)expected);
+            bugReport();
+        }
+    }
+    printf(" PASSED\n\n");
+}
+
+// MOVE.W #$2000,SR; MOVE.L #$52464E73,$1210.W (ADDQ.W #1,D6; RTE)
+// LEA $1210.W,A2; LEA $1200.W,A3
+// loop: TRAP #0; MOVE.L #$1210,$80.W; TRAP #0; MOVE.W #$1200,$82.W; TRAP #0
+//       MOVEM.L A2-A3,$84.W; TRAP #1; TRAP #2; MOVEM.L A2-A3,$88.W; TRAP #2
+//       EXG A2,A3; ADDQ.L #1,D0; BRA.S loop
+const u16 vectorGuest[32] = {
+    0x46FC, 0x2000, 0x21FC, 0x5246, 0x4E73, 0x1210, 0x45F8, 0x1210,
+    0x47F8, 0x1200, 0x4E40, 0x21FC, 0x0000, 0x1210, 0x0080, 0x4E40,
+    0x31FC, 0x1200, 0x0082, 0x4E40, 0x48F8, 0x0C00, 0x0084, 0x4E41,
+    0x4E42, 0x48F8, 0x0C00, 0x0088, 0x4E42, 0xC54B, 0x5280, 0x60D4 };
+
+u64 runVectors(bool cache, bool direct, u32 wp)
+{
+    std::unique_ptr<FleetCPU> cpu(new FleetCPU());
+
+    if (direct) cpu->mapMemory(0x000000, 0x10000, MEM_RAM, cpu->mem);
+    cpu->configVectorCache(cache);
+    loadGuest(*cpu, vectorGuest, 32);
+    if (wp) cpu->debugger.watchpoints.addAt(wp);
+
+    runGuest(*cpu, GUEST_CYCLES);
+    return hashGuest(*cpu);
+}
+
+void testVectors()
+{
+    printf("Verifying the vector cache ");
+
+    u64 expected = runVectors(false, false, 0);
+
+    // Bus accesses, mapped memory, and watchpoints inside and outside the table
+    const bool direct[4] = { false, true, true, false };
+    const u32 wp[4] = { 0, 0, 0x4000, 0x80 };
+
+    for (int i = 0; i < 4; i++) {
+
+        printf("."); fflush(stdout);
+        u64 result = runVectors(true, direct[i], wp[i]);
+
+        if (result != expected) {
+
+            printf("\nVECTOR CACHE MISMATCH FOUND (%s, watchpoint at %x)",
+                   direct[i] ? "RAM" : "IO", wp[i]);
+            printf(": Hash: %016llx Expected: %016llx\n\n",
+                   (unsigned long long)result, (unsigned long long)expected);
+            bugReport();
+        }
+    }
+    printf(" PASSED\n\n");
+}
+
+// Bus slot allocations covering the first half of a guest run (2 cycles each)
+static const int slotCount = GUEST_CYCLES / 4;
+static u64 slotMaps[2][slotCount / 64 + 1];
+static i64 slotStart;
+
+u64 runBus(const u16 *prog, int words, int feature, BusRecorder &recorder)
+{
+    std::unique_ptr<FleetCPU> cpu(new FleetCPU());
+
+    cpu->configRelaxedTiming(feature == 1);
+    cpu->configLongAccess(feature == 2);
+    loadGuest(*cpu, prog, words);
+
+    if (feature >= 3) {
+
+        slotStart = cpu->getClock();
+        cpu->setBusSlots(slotStart, 2, slotMaps[feature - 3], slotCount);
+    }
+
+    recorder.clear();
+    cpu->recorder = &recorder;
+    runGuest(*cpu, GUEST_CYCLES);
+    return hashGuest(*cpu);
+}
+
+static void hash(u64 &h, const BusRecord &r, bool cycles)
+{
+    hash(h, (u64)r.type << 40 | (u64)r.fc << 32 | r.addr);
+    hash(h, r.value);
+    if (cycles) hash(h, (u64)r.cycle);
+}
+
+u64 hashBus(const BusRecorder &recorder, bool cycles)
+{
+    u64 h = 1469598103934665603ULL;
+
+    for (long i = 0; i < recorder.size(); i++) {
+
+        // Hash the halves of a long word in ascending order
+        if (i + 1 < recorder.size() && recorder[i].type == BUS_POKE16 &&
+            recorder[i + 1].type == BUS_POKE16 && recorder[i].addr == recorder[i + 1].addr + 2) {
+
+            hash(h, recorder[i + 1], cycles);
+            hash(h, recorder[i], cycles);
+            i++;
+            continue;
+        }
+        hash(h, recorder[i], cycles);
+    }
+    return h;
+}
+
+long countSlotViolations(const BusRecorder &recorder)
+{
+    long violations = 0;
+
+    for (long i = 0; i < recorder.size(); i++) {
+
+        // Each access is recorded two cycles after its bus cycle has started
+        i64 n = (recorder[i].cycle - 2 - slotStart) / 2;
+        if (n >= 0 && n < slotCount && ((slotMaps[1][n >> 6] >> (n & 63)) & 1)) violations++;
+    }
+    return violations;
+}
+
+void testBus()
+{
+    printf("Verifying the bus features ");
+
+    const u16 *guests[4] = { idleGuest, movemGuest, frameGuest, vectorGuest };
+    const int words[4] = { 17, 29, 11, 32 };
+    const char *features[4] = {
+        "", "relaxed timing", "long word accesses", "bus arbitration" };
+    BusRecorder recorder;
+
+    // Occupy about a quarter of the slots
+    for (int i = 0; i < slotCount / 64 + 1; i++) {
+
+        slotMaps[0][i] = 0;
+        slotMaps[1][i] = ((u64)rand() << 32 ^ (u64)rand()) & ((u64)rand() << 32 ^ (u64)rand());
+    }
+
+    for (int i = 0; i < 4; i++) {
+
+        printf("."); fflush(stdout);
+        u64 expected = runBus(guests[i], words[i], 0, recorder);
+        u64 expectedBus = hashBus(recorder, false);
+        u64 expectedCycles = hashBus(recorder, true);
+
+        for (int feature = 1; feature < 4; feature++) {
+
+            // Free slots must not change the cycles of the accesses
+            u64 result = runBus(guests[i], words[i], feature, recorder);
+            u64 resultBus = hashBus(recorder, feature == 3);
+
+            if (result != expected || resultBus != (feature == 3 ? expectedCycles : expectedBus)) {
+
+                printf("\nBUS MISMATCH FOUND (guest %d, %s)", i, features[feature]);
+                printf(": Hash: %016llx/%016llx Expected: %016llx/%016llx\n\n",
+                       (unsigned long long)result, (unsigned long long)resultBus,
+                       (unsigned long long)expected, (unsigned long long)expectedBus);
+                bugReport();
+            }
+        }
+
+        // Occupied slots must never be used
+        runBus(guests[i], words[i], 4, recorder);
+        long violations = countSlotViolations(recorder);
+
+        if (violations) {
+
+            printf("\nBUS MISMATCH FOUND (guest %d, %ld accesses in occupied slots)\n\n",
+                   i, violations);
+            bugReport();
+        }
+    }
+    printf(" PASSED\n\n");
+}
+
+void testRecorder()
+{
+    printf("Verifying the bus recorder ");
+
+    const u16 *guests[4] = { idleGuest, movemGuest, frameGuest, vectorGuest };
+    const int words[4] = { 17, 29, 11, 32 };
+    BusRecorder recorder, loaded;
+
+    for (int i = 0; i < 4; i++) {
+
+        printf("."); fflush(stdout);
+        runBus(guests[i], words[i], 0, recorder);
+
+        // Save the recording
+        FILE *file = tmpfile();
+        bool error = !file || !recorder.save(file);
+
+        // Check the header and the little endian encoding of the first record
+        u8 header[36] = { };
+        if (!error) {
+
+            rewind(file);
+            error = fread(header, 1, sizeof(header), file) != sizeof(header);
+            error |= memcmp(header, "MOIRABUS", 8) != 0;
+            error |= header[8] != 1 || header[9] || header[10] || header[11];
+
+            u64 count = 0, cycle = 0;
+            for (int j = 7; j >= 0; j--) count = count << 8 | header[12 + j];
+            for (int j = 7; j >= 0; j--) cycle = cycle << 8 | header[20 + j];
+            u32 addr = header[28] | header[29] << 8 | header[30] << 16 | (u32)header[31] << 24;
+            u16 value = (u16)(header[32] | header[33] << 8);
+            const BusRecord &r = recorder[0];
+
+            error |= count != (u64)recorder.size();
+            error |= cycle != (u64)r.cycle || addr != r.addr || value != r.value;
+            error |= header[34] != r.type || header[35] != r.fc;
+        }
+
+        // Load the recording and replay it
+        if (!error) {
+
+            rewind(file);
+            error = !loaded.load(file) || loaded.size() != recorder.size();
+        }
+        if (file) fclose(file);
+
+        BusReplayer replayer(loaded);
+        for (long j = 0; !error && j < recorder.size(); j++) {
+
+            const BusRecord &r = recorder[j];
+            BusAccess type = (BusAccess)r.type;
+
+            if (type == BUS_PEEK8 || type == BUS_PEEK16 || type == BUS_POLL) {
+                error |= replayer.read(type, r.addr, r.fc, r.cycle) != r.value;
+            } else {
+                error |= !replayer.write(type, r.addr, r.value, r.fc, r.cycle);
+            }
+        }
+        error |= !replayer.atEnd() || replayer.getMismatches() != 0;
+
+        // A different function code must be reported as a mismatch
+        replayer.rewind();
+        const BusRecord &r = recorder[0];
+        replayer.read((BusAccess)r.type, r.addr, (u8)(r.fc ^ 1));
+        error |= replayer.getMismatches() != 1 || replayer.position() != 0;
+
+        if (error) {
+
+            printf("\nRECORDER MISMATCH FOUND (guest %d)\n\n", i);
+            bugReport();
+        }
+    }
+    printf(" PASSED\n\n");
+}
+
+void benchmarkMul()
+{
+    const char *names[2] = { "MULU", "MULS" };
+    const Instr instr[2] = { MULU, MULS };
+    volatile long sum = 0;
+
+    for (int i = 0; i < 2; i++) {
+
+        clock_t start = clock();
+        for (int j = 0; j < 1000; j++) {
+            for (int op = 0; op < 0x10000; op++) sum += moiracpu->getMulCycles(instr[i], (u16)op);
+        }
+        clock_t elapsed = clock() - start;
+
+        start = clock();
+        for (int j = 0; j < 1000; j++) {
+            for (int op = 0; op < 0x10000; op++) sum += referenceMulCycles(i == 1, (u16)op);
+        }
+        clock_t reference = clock() - start;
+
+        printf("Benchmarking %s timing: %.2fs (bit loop: %.2fs)\n", names[i],
+               elapsed / double(CLOCKS_PER_SEC), reference / double(CLOCKS_PER_SEC));
+    }
+    printf("\n");
+}
+
 void runSingleTest(Setup &s)
 {
     Result mur, mor;
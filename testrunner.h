@@ -16,9 +16,11 @@
 #include <string.h>
 #include <time.h>
 #include <assert.h>
+#include <algorithm>
 
 #include "Sandbox.h"
 #include "TestCPU.h"
+#include "MoiraScheduler.h"
 
 // Musashi
 extern "C" {
@@ -102,6 +104,149 @@ void setupInstruction(Setup &s, uint32_t pc, uint16_t opcode);
 void resetMusashi(Setup &s);
 void resetMoira(Setup &s);
 
+//
+// Verifying lookup tables
+//
+
+// Reference implementation of the BCD arithmetic (returns result and CCR)
+u16 referenceBcd(bool sub, u8 op1, u8 op2, bool x);
+
+// Runs ABCD, SBCD, and NBCD with all possible operands
+void testBcd();
+
+// Reference implementation of the shift and rotate instructions (bit by bit)
+// (type: 0 = AS, 1 = LS, 2 = ROX, 3 = RO; returns CCR << 32 | result)
+u64 referenceShift(int type, bool left, int size, int cnt, u32 data, bool x);
+
+// Compares the shift and rotate instructions with the reference for all counts
+void testShift();
+
+// Reference implementation of the MULU and MULS timing (bit by bit)
+int referenceMulCycles(bool sign, u16 data);
+
+// Compares the MULU and MULS timing with the reference for all operands
+void testMul();
+
+// Reference implementation of the DIVU and DIVS timing (simulates the divider)
+int referenceDivCycles(bool sign, u32 dividend, u16 divisor);
+
+// Compares the DIVU and DIVS timing with the reference for all divisors
+void testDiv();
+
+//
+// Verifying the multi-CPU support
+//
+
+// Runs a fleet of CPUs on the scheduler and returns a hash of the final state
+u64 runFleet(int threads);
+
+// Checks that the fleet produces the same results for any number of threads
+void testScheduler();
+
+// Runs CPUs sharing memory on the coordinator and returns a hash of the final state
+u64 runSharedFleet(int threads);
+
+// Checks that the parallel coordinator produces the same results for any
+// number of threads
+void testCoordinator();
+
+//
+// Verifying the event queue and the optional features
+//
+
+// Number of cycles a guest program is run for
+#define GUEST_CYCLES 200000
+
+// A program that polls memory, runs a delay loop, and waits in the stop state
+extern const u16 idleGuest[17];
+
+// Copies a program to $1000, points all exception vectors to a handler at
+// $1200 (ADDQ.W #1,D7; RTE), and resets the CPU
+void loadGuest(FleetCPU &cpu, const u16 *prog, int words);
+
+// Returns the trigger cycle of a callback relative to the start of the guest
+// (pairs of callbacks share the same cycle)
+i64 guestCallback(int nr);
+
+// Schedules callbacks and interrupts and runs the guest in slices of 'chunk'
+// cycles by calling executeUntil()
+void runGuest(FleetCPU &cpu, i64 chunk);
+
+// Returns a hash of the registers, the clock, the memory, and the callbacks
+u64 hashGuest(FleetCPU &cpu);
+
+// Checks the order of served events and the slicing of executeUntil()
+void testEvents();
+
+// Runs the idle guest with fast-forwarding features enabled and returns a
+// hash of the final state (bit 0 = stop state skipping, bit 1 = idle loop
+// detection, bit 2 = delay loop skipping)
+u64 runFastForward(int features, i64 chunk);
+
+// Checks that fast-forwarding doesn't change the result of the idle guest
+void testFastForward();
+
+//
+// Verifying the memory map
+//
+
+// Runs a program accessing odd and page-crossing words and returns a hash of
+// the final state (the memory is either mapped as RAM or accessed via the bus)
+u64 runRegions(bool direct);
+
+// Checks that RAM regions behave like IO regions
+void testRegions();
+
+// A program that transfers registers with MOVEM in all addressing modes
+extern const u16 movemGuest[29];
+
+// A program that triggers exceptions which write a stack frame
+extern const u16 frameGuest[11];
+
+// Runs a guest with its memory either mapped as RAM or accessed via the bus
+// and returns a hash of the final state
+u64 runMapped(const u16 *prog, int words, bool direct);
+
+// Checks that the block transfers and stack frame writes to mapped memory
+// don't change the results
+void testBlocks();
+
+// A program that rewrites exception vectors between calling them
+extern const u16 vectorGuest[32];
+
+// Runs the vector guest with the vector cache enabled or disabled and returns
+// a hash of the final state (a watchpoint is set at 'wp' unless it is zero)
+u64 runVectors(bool cache, bool direct, u32 wp);
+
+// Checks that the vector cache doesn't change the results
+void testVectors();
+
+// Runs a guest with an optional bus feature enabled (1 = relaxed timing,
+// 2 = long word accesses, 3 = bus arbitration with free slots, 4 = bus
+// arbitration with occupied slots), records all bus accesses, and returns a
+// hash of the final state
+u64 runBus(const u16 *prog, int words, int feature, BusRecorder &recorder);
+
+// Returns a hash of a recording (with or without the recorded cycles). The
+// two halves of a long word may be written in either order.
+u64 hashBus(const BusRecorder &recorder, bool cycles);
+
+// Returns the number of recorded accesses in occupied slots (feature 4)
+long countSlotViolations(const BusRecorder &recorder);
+
+// Checks that the optional bus features don't change the bus accesses
+void testBus();
+
+// Checks that a recording survives saving, loading, and replaying it
+void testRecorder();
+
+//
+// Benchmarking
+//
+
+// Measures the speed of the MULU and MULS cycle computation (testrunner --bench)
+void benchmarkMul();
+
 //
 // Performing a test
 //